@@ -0,0 +1,180 @@
+#include "achievements.hpp"
+
+AchievementManager& AchievementManager::getInstance() {
+    static AchievementManager instance;
+    return instance;
+}
+
+void AchievementManager::init() {
+    createAchievements();
+}
+
+void AchievementManager::createAchievements() {
+    achievements.clear();
+
+    // Conquistas baseadas em pontuação
+    achievements.emplace_back(1, "Primeiro Passo", "Alcance 1.000 pontos", SCORE_BASED, 1000, 1);
+    achievements.emplace_back(2, "Reciclador Iniciante", "Alcance 5.000 pontos", SCORE_BASED, 5000, 2);
+    achievements.emplace_back(3, "Eco Guerreiro", "Alcance 25.000 pontos", SCORE_BASED, 25000, 3);
+    achievements.emplace_back(4, "Mestre da Reciclagem", "Alcance 100.000 pontos", SCORE_BASED, 100000, 4);
+    achievements.emplace_back(5, "Lenda Ecológica", "Alcance 500.000 pontos", SCORE_BASED, 500000, 5);
+
+    // Conquistas baseadas em linhas
+    achievements.emplace_back(6, "Primeira Limpeza", "Limpe 10 linhas", LINES_BASED, 10, 6);
+    achievements.emplace_back(7, "Limpador Eficiente", "Limpe 100 linhas", LINES_BASED, 100, 7);
+    achievements.emplace_back(8, "Máquina de Limpeza", "Limpe 500 linhas", LINES_BASED, 500, 8);
+    achievements.emplace_back(9, "Demolidor Ecológico", "Limpe 1000 linhas", LINES_BASED, 1000, 9);
+
+    // Conquistas baseadas em nível
+    achievements.emplace_back(10, "Subindo de Nível", "Alcance o nível 5", LEVEL_BASED, 5, 10);
+    achievements.emplace_back(11, "Especialista", "Alcance o nível 10", LEVEL_BASED, 10, 11);
+    achievements.emplace_back(12, "Mestre", "Alcance o nível 20", LEVEL_BASED, 20, 12);
+    achievements.emplace_back(13, "Lenda", "Alcance o nível 50", LEVEL_BASED, 50, 13);
+
+    // Conquistas específicas por tipo de lixo
+    achievements.emplace_back(14, "Amigo do Papel", "Recicle 100 itens de papel", RECYCLE_BASED, 100, 14, PAPER);
+    achievements.emplace_back(15, "Guerreiro do Plástico", "Recicle 100 itens de plástico", RECYCLE_BASED, 100, 15, PLASTIC);
+    achievements.emplace_back(16, "Coletor de Metal", "Recicle 100 itens de metal", RECYCLE_BASED, 100, 16, METAL);
+    achievements.emplace_back(17, "Protetor do Vidro", "Recicle 100 itens de vidro", RECYCLE_BASED, 100, 17, GLASS);
+    achievements.emplace_back(18, "Composteiro", "Recicle 100 itens orgânicos", RECYCLE_BASED, 100, 18, ORGANIC);
+
+    // Conquistas avançadas de reciclagem
+    achievements.emplace_back(19, "Reciclador Completo", "Recicle 50 itens de cada tipo", SPECIAL, 50, 19);
+    achievements.emplace_back(20, "Eco Champion", "Recicle 1000 itens no total", SPECIAL, 1000, 20);
+
+    // Conquistas de combo
+    achievements.emplace_back(21, "Combo Iniciante", "Faça um combo de 3", COMBO_BASED, 3, 21);
+    achievements.emplace_back(22, "Combo Master", "Faça um combo de 5", COMBO_BASED, 5, 22);
+    achievements.emplace_back(23, "Combo Legend", "Faça um combo de 10", COMBO_BASED, 10, 23);
+
+    // Conquistas especiais
+    achievements.emplace_back(24, "Velocista Ecológico", "Alcance nível 10 em menos de 5 minutos", SPECIAL, 1, 24);
+    achievements.emplace_back(25, "Perfeccionista", "Complete um nível sem errar uma peça", SPECIAL, 1, 25);
+}
+
+void AchievementManager::checkAchievements(const Game& game) {
+    for (auto& achievement : achievements) {
+        if (!achievement.unlocked && isMet(achievement, game)) {
+            unlockAchievement(achievement.id);
+        }
+    }
+}
+
+void AchievementManager::handleEvent(const GameEvent& event, const Game& game) {
+    switch (event.type) {
+        case EVENT_LINES_CLEARED:
+            // Pontos e contagens de reciclagem só mudam quando linhas saem
+            checkType(game, SCORE_BASED);
+            checkType(game, LINES_BASED);
+            checkType(game, RECYCLE_BASED);
+            checkType(game, SPECIAL);
+            break;
+
+        case EVENT_LEVEL_UP:
+            checkType(game, LEVEL_BASED);
+            break;
+
+        case EVENT_COMBO_CHANGED:
+            checkType(game, COMBO_BASED);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void AchievementManager::checkType(const Game& game, AchievementType type) {
+    for (auto& achievement : achievements) {
+        if (achievement.type == type && !achievement.unlocked && isMet(achievement, game)) {
+            unlockAchievement(achievement.id);
+        }
+    }
+}
+
+bool AchievementManager::isMet(const Achievement& achievement, const Game& game) const {
+    switch (achievement.type) {
+        case SCORE_BASED:
+            return game.getScore() >= achievement.target_value;
+
+        case LINES_BASED:
+            return game.getLinesCleared() >= achievement.target_value;
+
+        case LEVEL_BASED:
+            return game.getLevel() >= achievement.target_value;
+
+        case RECYCLE_BASED:
+            if (achievement.specific_trash != NONE) {
+                return game.getRecycledCount(achievement.specific_trash) >= achievement.target_value;
+            }
+            return false;
+
+        case COMBO_BASED:
+            return game.getComboCount() >= achievement.target_value;
+
+        case SPECIAL:
+            // Lógica especial para cada conquista
+            if (achievement.id == 19) { // Reciclador Completo
+                for (int i = 0; i < 5; i++) {
+                    if (game.getRecycledCount(static_cast<TrashType>(i)) < achievement.target_value) {
+                        return false;
+                    }
+                }
+                return true;
+            } else if (achievement.id == 20) { // Eco Champion
+                int total_recycled = 0;
+                for (int i = 0; i < 5; i++) {
+                    total_recycled += game.getRecycledCount(static_cast<TrashType>(i));
+                }
+                return total_recycled >= achievement.target_value;
+            }
+            return false;
+    }
+    return false;
+}
+
+void AchievementManager::unlockAchievement(int achievement_id) {
+    for (auto& achievement : achievements) {
+        if (achievement.id == achievement_id && !achievement.unlocked) {
+            achievement.unlocked = true;
+            latest_achievement = achievement;
+            new_achievement_notification = true;
+
+            // Aqui você pode adicionar efeitos sonoros ou visuais
+            // SoundManager::getInstance().playSound("achievement_unlock");
+            break;
+        }
+    }
+}
+
+std::vector<Achievement> AchievementManager::getUnlockedAchievements() const {
+    std::vector<Achievement> unlocked;
+    for (const auto& achievement : achievements) {
+        if (achievement.unlocked) {
+            unlocked.push_back(achievement);
+        }
+    }
+    return unlocked;
+}
+
+std::vector<Achievement> AchievementManager::getLockedAchievements() const {
+    std::vector<Achievement> locked;
+    for (const auto& achievement : achievements) {
+        if (!achievement.unlocked) {
+            locked.push_back(achievement);
+        }
+    }
+    return locked;
+}
+
+int AchievementManager::getUnlockedCount() const {
+    int count = 0;
+    for (const auto& achievement : achievements) {
+        if (achievement.unlocked) count++;
+    }
+    return count;
+}
+
+float AchievementManager::getCompletionPercentage() const {
+    if (achievements.empty()) return 0.0f;
+    return (float)getUnlockedCount() / (float)achievements.size() * 100.0f;
+}
@@ -0,0 +1,100 @@
+#include "autoplayer.hpp"
+#include <algorithm>
+#include <chrono>
+
+typedef std::chrono::steady_clock AutoClock;
+
+AutoPlayer::AutoPlayer(const AutoWeights &weights, int budget_us) : weights(weights), budget_us(budget_us) {}
+
+Move AutoPlayer::think(const Game &game){
+    AutoClock::time_point start = AutoClock::now();
+    AutoClock::time_point deadline = start + std::chrono::microseconds(budget_us);
+
+    // Sem alternativa, a peça cai onde está
+    Move best = {(int8_t)game.getCurrentRotation(), (int8_t)game.getCurrentX(), (int8_t)game.getCurrentY(), false};
+    if (game.hasActivePiece()) {
+        best.y = (int8_t)game.landingRow();
+        generator.generate(game, moves, game.canHold());
+        GameState before = game.snapshot();
+        scratch.setRules(game.getRules());
+        evaluator.setWeights(toEvalWeights(weights, game.getRules()));
+
+        double best_value = -1e300;
+        for (size_t first = 0; first < moves.size(); first += BoardEvaluator::Lanes) {
+            // Pelo menos um lote é avaliado, mesmo com o orçamento estourado
+            if (budget_us > 0 && first > 0 && AutoClock::now() >= deadline) {
+                truncated_count++;
+                break;
+            }
+
+            int count = (int)std::min(moves.size() - first, (size_t)BoardEvaluator::Lanes);
+            for (int k = 0; k < count; k++) {
+                scratch.restore(before);
+                MoveGenerator::apply(scratch, moves[first + k]);
+                evaluator.load(k, scratch.getBoardView());
+                points[k] = scratch.getScore() - game.getScore();
+                game_over[k] = scratch.getGameOver();
+            }
+            evaluator.run(count, values);
+
+            // Mesma conta de evaluateBoard
+            for (int k = 0; k < count; k++) {
+                double value = game_over[k] ? -1e9 : values[k] + weights.score * points[k];
+                if (value > best_value) {
+                    best_value = value;
+                    best = moves[first + k];
+                }
+            }
+        }
+    }
+
+    last_decision_us = (int)std::chrono::duration_cast<std::chrono::microseconds>(AutoClock::now() - start).count();
+    if (last_decision_us > max_decision_us) max_decision_us = last_decision_us;
+    return best;
+}
+
+void AutoPlayer::play(Game &game){
+    if (!game.hasActivePiece()) return;
+    MoveGenerator::apply(game, think(game));
+}
+
+Placement AutoPlayer::choose(const Game &game){
+    Move move = think(game);
+    Placement placement = {move.rotation, move.x, move.hold};
+    return placement;
+}
+
+double AutoPlayer::evaluate(const Game &before, const Game &after) const {
+    return evaluateBoard(weights, after, after.getScore() - before.getScore());
+}
+
+double evaluateBoard(const AutoWeights &weights, const Game &after, int points){
+    if (after.getGameOver()) return -1e9;
+    return evaluatePosition(weights, after) + weights.score * points;
+}
+
+double evaluatePosition(const AutoWeights &weights, const Game &after){
+    if (after.getGameOver()) return -1e9;
+
+    int features[FEATURE_COUNT];
+    boardFeatures(after.getBoardView(), features);
+    return weighFeatures(toEvalWeights(weights, after.getRules()), features);
+}
+
+EvalWeights toEvalWeights(const AutoWeights &weights, const RulesConfig &rules){
+    EvalWeights eval;
+    eval.feature[FEATURE_HEIGHT] = weights.height;
+    eval.feature[FEATURE_HOLES] = weights.holes;
+    eval.feature[FEATURE_COVERED] = weights.covered;
+    eval.feature[FEATURE_BUMPINESS] = weights.bumpiness;
+    eval.feature[FEATURE_ROW_TRANSITIONS] = weights.row_transitions;
+    eval.feature[FEATURE_COLUMN_TRANSITIONS] = weights.column_transitions;
+    eval.feature[FEATURE_WELLS] = weights.wells;
+
+    // O kernel soma preenchimento² por tipo; a fração da largura e a
+    // pontuação base entram no peso
+    for (int t = 0; t < NONE; t++) {
+        eval.feature[FEATURE_UNIFORM_PAPER + t] = weights.uniform * rules.base_scores[t] / 100.0 / (Game::Width * Game::Width);
+    }
+    return eval;
+}
@@ -0,0 +1,96 @@
+#ifndef AUTOPLAYER_HPP
+#define AUTOPLAYER_HPP
+
+#include "evaluator.hpp"
+#include "game.hpp"
+#include "movegen.hpp"
+#include "policy.hpp"
+
+// Pesos das características do tabuleiro depois da jogada. Alturas,
+// buracos, irregularidade e poços penalizam; linhas quase completas de um
+// único tipo e os pontos ganhos somam. Blocos sobre buracos e transições
+// começam desligados.
+struct AutoWeights {
+    double height = -0.51;            // Soma das alturas das colunas
+    double holes = -0.36;             // Células vazias sob algum bloco
+    double bumpiness = -0.18;         // Diferença de altura entre colunas vizinhas
+    double wells = -0.12;             // Profundidade dos poços (coluna abaixo das duas vizinhas)
+    double uniform = 0.60;            // Linhas de um só tipo: preenchimento² x pontuação base
+    double score = 0.01;              // Pontos ganhos na jogada
+    double covered = 0.0;             // Blocos com algum buraco abaixo
+    double row_transitions = 0.0;     // Trocas cheio/vazio ao longo das linhas
+    double column_transitions = 0.0;  // Trocas cheio/vazio ao longo das colunas
+};
+
+// Pesos por característica do BoardEvaluator; o termo uniforme de cada
+// tipo vem da pontuação base das regras
+EvalWeights toEvalWeights(const AutoWeights &weights, const RulesConfig &rules);
+
+// Valor do tabuleiro de game com esses pesos, somando points ganhos desde a
+// referência (usado também pelo planejador em feixe)
+double evaluateBoard(const AutoWeights &weights, const Game &game, int points);
+
+// Só a parte que depende do tabuleiro (sem os pontos): é função da posição,
+// então pode ser guardada pelo hash. Igual, bit a bit, ao BoardEvaluator com
+// os pesos de toEvalWeights.
+double evaluatePosition(const AutoWeights &weights, const Game &game);
+
+// Jogador automático: enumera todas as posições finais da peça atual (com
+// o hold, se disponível) pelo MoveGenerator e fica com a de melhor
+// avaliação, feita em lotes pelo BoardEvaluator. A decisão respeita um
+// orçamento de tempo: esgotado, vale a melhor jogada avaliada até ali.
+// Serve à tela (modo demonstração) e, como Policy, ao simulador.
+class AutoPlayer : public Policy{
+    public:
+        static const int DEFAULT_BUDGET_US = 1000;
+
+        explicit AutoPlayer(const AutoWeights &weights = AutoWeights(), int budget_us = DEFAULT_BUDGET_US);
+
+        // Melhor jogada para a peça atual (a atual, se não houver nenhuma)
+        Move think(const Game &game);
+
+        // Decide e trava a peça na posição escolhida
+        void play(Game &game);
+
+        // Como Policy: rotação, coluna e hold da jogada escolhida. Encaixes
+        // por baixo de saliências viram hard drop na mesma coluna.
+        Placement choose(const Game &game);
+
+        // Valor do tabuleiro de after, com before como referência dos pontos
+        double evaluate(const Game &before, const Game &after) const;
+
+        const AutoWeights &getWeights() const { return weights; }
+        void setWeights(const AutoWeights &new_weights) { weights = new_weights; }
+
+        BatchIsa getIsa() const { return evaluator.getIsa(); }
+
+        // Orçamento por decisão em microssegundos; 0 = sem limite, e então
+        // a escolha depende só do estado do jogo (reprodutível)
+        void setBudget(int budget) { budget_us = budget; }
+        int getBudget() const { return budget_us; }
+
+        // Tempo da última decisão, o maior até agora e quantas foram
+        // cortadas pelo orçamento
+        int getLastDecisionMicros() const { return last_decision_us; }
+        int getMaxDecisionMicros() const { return max_decision_us; }
+        int getTruncatedCount() const { return truncated_count; }
+
+    private:
+        AutoWeights weights;
+        int budget_us;
+        int last_decision_us = 0;
+        int max_decision_us = 0;
+        int truncated_count = 0;
+
+        MoveGenerator generator;
+        std::vector<Move> moves;
+        Game scratch;
+
+        // Um lote de jogadas aplicadas, avaliado de uma vez
+        BoardEvaluator evaluator;
+        int points[BoardEvaluator::Lanes];
+        bool game_over[BoardEvaluator::Lanes];
+        double values[BoardEvaluator::Lanes];
+};
+
+#endif // AUTOPLAYER_HPP
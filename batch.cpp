@@ -0,0 +1,569 @@
+#include "batch.hpp"
+#include <string.h>
+
+// Vetores de N lanes de 16 bits (extensões de vetor do GCC). O mesmo kernel
+// vira código escalar com N = 1, SSE2 com N = 8 e AVX2 com N = 16 quando a
+// função que o chama é compilada para esse alvo.
+template<int N>
+struct Simd {
+    typedef uint16_t U __attribute__((vector_size(2 * N)));
+    typedef int16_t S __attribute__((vector_size(2 * N)));
+    typedef uint8_t B __attribute__((vector_size(N)));
+};
+
+// Os auxiliares abaixo são sempre expandidos dentro do kernel, então a nota
+// de ABI sobre vetores AVX passados fora de funções AVX não se aplica (ela é
+// desligada com -Wno-psabi no Makefile; o pragma não alcança essa nota)
+#define BATCH_INLINE static inline __attribute__((always_inline))
+
+template<int N>
+BATCH_INLINE typename Simd<N>::U load(const uint16_t *p){
+    typename Simd<N>::U v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Carrega N bytes e estende cada um para 16 bits
+template<int N>
+BATCH_INLINE typename Simd<N>::U loadBytes(const uint8_t *p){
+    typename Simd<N>::B v;
+    memcpy(&v, p, sizeof(v));
+    return __builtin_convertvector(v, typename Simd<N>::U);
+}
+
+template<int N>
+BATCH_INLINE typename Simd<N>::S loadSigned(const int16_t *p){
+    typename Simd<N>::S v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+template<int N, class V>
+BATCH_INLINE void store(void *p, V v){
+    memcpy(p, &v, sizeof(v));
+}
+
+// True se alguma lane do vetor for diferente de zero
+template<int N>
+BATCH_INLINE bool any(typename Simd<N>::U v){
+    uint64_t words[(2 * N + 7) / 8] = {};
+    memcpy(words, &v, sizeof(v));
+    uint64_t acc = 0;
+    for (unsigned i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        acc |= words[i];
+    }
+    return acc != 0;
+}
+
+template<int N>
+BATCH_INLINE typename Simd<N>::U select(typename Simd<N>::U mask, typename Simd<N>::U a, typename Simd<N>::U b){
+    return (mask & a) | (~mask & b);
+}
+
+// Desce uma linha as peças das lanes em moving que têm espaço; devolve a
+// máscara das lanes que desceram
+template<int K, int N>
+BATCH_INLINE typename Simd<N>::U dropOnce(BatchLanes<K> &d, int o, typename Simd<N>::U moving, typename Simd<N>::S &y){
+    typedef typename Simd<N>::U U;
+    typedef typename Simd<N>::S S;
+    const int H = BatchLanes<K>::Height;
+    const U zero = {};
+
+    U floor = (U)(load<N>(&d.piece[0][o]) != zero);
+    U hit = zero;
+    for (int r = 0; r < H - 1; r++) {
+        hit |= load<N>(&d.rows[r][o]) & load<N>(&d.piece[r + 1][o]);
+    }
+    U ok = moving & ~floor & (U)(hit == zero);
+    if (!any<N>(ok)) return ok;
+
+    for (int r = 0; r < H; r++) {
+        U next = r + 1 < H ? load<N>(&d.piece[r + 1][o]) : zero;
+        store<N>(&d.piece[r][o], select<N>(ok, next, load<N>(&d.piece[r][o])));
+    }
+    y -= (S)(ok & 1);
+    return ok;
+}
+
+// Um passo de todas as lanes: translação, rotação, queda e trava
+template<int K, int N>
+BATCH_INLINE void stepLanes(BatchLanes<K> &d){
+    typedef typename Simd<N>::U U;
+    typedef typename Simd<N>::S S;
+    const int H = BatchLanes<K>::Height;
+    const U zero = {};
+
+    for (int o = 0; o < K; o += N) {
+        U actions = loadBytes<N>(&d.actions[o]);
+        U active = load<N>(&d.active[o]);
+        U left = active & (U)(actions == (uint16_t)BATCH_LEFT);
+        U right = active & (U)(actions == (uint16_t)BATCH_RIGHT);
+        U down = active & (U)(actions == (uint16_t)BATCH_DOWN);
+        U hard = active & (U)(actions == (uint16_t)BATCH_HARD_DROP);
+        U rotate = load<N>(&d.rotate[o]);
+        S x = loadSigned<N>(&d.x[o]);
+        S y = loadSigned<N>(&d.y[o]);
+        U locked = zero;
+
+        // Translação: a peça inteira desloca um bit; bate na parede se já
+        // tiver célula na coluna da borda
+        if (any<N>(left | right)) {
+            U span = zero, hit_left = zero, hit_right = zero;
+            for (int r = 0; r < H; r++) {
+                U p = load<N>(&d.piece[r][o]);
+                U row = load<N>(&d.rows[r][o]);
+                span |= p;
+                hit_left |= row & (p >> 1);
+                hit_right |= row & (p << 1);
+            }
+            U ok_left = left & (U)((span & 1) == zero) & (U)(hit_left == zero);
+            U ok_right = right & (U)((span & (1 << (Board::Width - 1))) == zero) & (U)(hit_right == zero);
+            for (int r = 0; r < H; r++) {
+                U p = load<N>(&d.piece[r][o]);
+                store<N>(&d.piece[r][o], select<N>(ok_left, p >> 1, select<N>(ok_right, p << 1, p)));
+            }
+            x += (S)(ok_right & 1) - (S)(ok_left & 1);
+        }
+
+        // Rotação: a peça girada já vem desenhada (e dentro do tabuleiro)
+        if (any<N>(rotate)) {
+            U hit = zero;
+            for (int r = 0; r < H; r++) {
+                hit |= load<N>(&d.rows[r][o]) & load<N>(&d.candidate[r][o]);
+            }
+            rotate &= (U)(hit == zero);
+            for (int r = 0; r < H; r++) {
+                store<N>(&d.piece[r][o], select<N>(rotate, load<N>(&d.candidate[r][o]), load<N>(&d.piece[r][o])));
+            }
+        }
+
+        // Queda de uma linha; quem não consegue descer trava
+        if (any<N>(down)) {
+            U moved = dropOnce<K, N>(d, o, down, y);
+            locked |= down & ~moved;
+        }
+
+        // Hard drop: desce até todas as lanes pousarem
+        if (any<N>(hard)) {
+            U moving = hard;
+            while (any<N>(moving)) {
+                moving = dropOnce<K, N>(d, o, moving, y);
+            }
+            locked |= hard;
+        }
+
+        // Trava: a peça entra nas linhas e nos planos de tipo e sai de cena
+        if (any<N>(locked)) {
+            U type_bits[BatchLanes<K>::TypePlanes];
+            for (int b = 0; b < BatchLanes<K>::TypePlanes; b++) {
+                type_bits[b] = load<N>(&d.type_bits[b][o]);
+            }
+            for (int r = 0; r < H; r++) {
+                U p = load<N>(&d.piece[r][o]) & locked;
+                store<N>(&d.rows[r][o], load<N>(&d.rows[r][o]) | p);
+                for (int b = 0; b < BatchLanes<K>::TypePlanes; b++) {
+                    U plane = load<N>(&d.planes[b][r][o]);
+                    store<N>(&d.planes[b][r][o], (plane & ~p) | (p & type_bits[b]));
+                }
+                store<N>(&d.piece[r][o], load<N>(&d.piece[r][o]) & ~locked);
+            }
+            store<N>(&d.active[o], active & ~locked);
+        }
+
+        store<N>(&d.x[o], x);
+        store<N>(&d.y[o], y);
+        store<N>(&d.rotate[o], rotate);
+        store<N>(&d.locked[o], locked);
+    }
+}
+
+// Remoção de linhas em todas as lanes: a cada passada, cada lane tira uma
+// linha (a mais alta ainda pendente) e tudo acima dela desce uma posição
+template<int K, int N>
+BATCH_INLINE void compactLanes(BatchLanes<K> &d, int passes){
+    typedef typename Simd<N>::U U;
+    typedef typename Simd<N>::S S;
+    const int H = BatchLanes<K>::Height;
+    const U zero = {};
+    const S no_rows = {};
+
+    for (int o = 0; o < K; o += N) {
+        for (int pass = 0; pass < passes; pass++) {
+            S cleared = loadSigned<N>(&d.clear_row[pass][o]);
+            for (int r = 0; r < H; r++) {
+                U shift = (U)((no_rows + (int16_t)r) >= cleared);
+                if (!any<N>(shift)) continue;
+
+                store<N>(&d.rows[r][o], select<N>(shift, r + 1 < H ? load<N>(&d.rows[r + 1][o]) : zero, load<N>(&d.rows[r][o])));
+                for (int b = 0; b < BatchLanes<K>::TypePlanes; b++) {
+                    U above = r + 1 < H ? load<N>(&d.planes[b][r + 1][o]) : zero;
+                    store<N>(&d.planes[b][r][o], select<N>(shift, above, load<N>(&d.planes[b][r][o])));
+                }
+            }
+        }
+    }
+}
+
+// Versões dos kernels para cada conjunto de instruções
+template<int K>
+static void stepScalar(BatchLanes<K> &d) { stepLanes<K, 1>(d); }
+template<int K>
+static void compactScalar(BatchLanes<K> &d, int passes) { compactLanes<K, 1>(d, passes); }
+
+template<int K>
+static void stepSse2(BatchLanes<K> &d) { stepLanes<K, 8>(d); }
+template<int K>
+static void compactSse2(BatchLanes<K> &d, int passes) { compactLanes<K, 8>(d, passes); }
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_HAS_AVX2 1
+template<int K>
+__attribute__((target("avx2"))) static void stepAvx2(BatchLanes<K> &d) { stepLanes<K, (K < 16 ? K : 16)>(d); }
+template<int K>
+__attribute__((target("avx2"))) static void compactAvx2(BatchLanes<K> &d, int passes) { compactLanes<K, (K < 16 ? K : 16)>(d, passes); }
+#endif
+
+BatchIsa bestBatchIsa(){
+#ifdef BATCH_HAS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return BATCH_AVX2;
+    return BATCH_SSE2;
+#else
+    return BATCH_SCALAR;
+#endif
+}
+
+const char *getBatchIsaName(BatchIsa isa){
+    switch (isa) {
+        case BATCH_AVX2: return "avx2";
+        case BATCH_SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+template<int K>
+BoardBatch<K>::BoardBatch(BatchIsa requested_isa){
+    BatchIsa best = bestBatchIsa();
+    isa = requested_isa > best ? best : requested_isa;
+    switch (isa) {
+#ifdef BATCH_HAS_AVX2
+        case BATCH_AVX2:
+            step_kernel = stepAvx2<K>;
+            compact_kernel = compactAvx2<K>;
+            break;
+#endif
+        case BATCH_SSE2:
+            step_kernel = stepSse2<K>;
+            compact_kernel = compactSse2<K>;
+            break;
+        default:
+            step_kernel = stepScalar<K>;
+            compact_kernel = compactScalar<K>;
+            break;
+    }
+
+    memset(&data, 0, sizeof(data));
+    for (int lane = 0; lane < K; lane++) {
+        reset(lane, lane);
+    }
+}
+
+template<int K>
+void BoardBatch<K>::reset(int lane, uint64_t seed_value){
+    Game game;
+    game.seed(seed_value);
+    game.restart();
+    setLaneState(lane, game.snapshot());
+}
+
+template<int K>
+void BoardBatch<K>::setLaneState(int lane, const GameState &state){
+    for (int y = 0; y < Height; y++) {
+        data.rows[y][lane] = state.board.getRow(y);
+        for (int p = 0; p < Board::TypePlanes; p++) {
+            data.planes[p][y][lane] = state.board.getTypePlane(p)[y];
+        }
+    }
+
+    LaneInfo &l = info[lane];
+    l.rng = state.rng;
+    l.score = state.score;
+    l.level = state.level;
+    l.lines_cleared = state.lines_cleared;
+    l.combo_count = state.combo_count;
+    l.pieces_placed = state.pieces_placed;
+    for (int i = 0; i < 5; i++) {
+        l.recycled_count[i] = state.recycled_count[i];
+    }
+    l.curr_shape = state.curr_shape;
+    l.curr_rotation = state.curr_rotation;
+    l.next_shape = state.next_shape;
+    l.hold_shape = state.hold_shape;
+    l.curr_type = state.curr_types[0];
+    l.next_type = state.next_types[0];
+    for (int i = 0; i < 4; i++) {
+        l.hold_types[i] = state.hold_types[i];
+    }
+    l.has_active_piece = state.has_active_piece;
+    l.can_hold = state.can_hold;
+    l.game_over = state.game_over;
+
+    data.x[lane] = state.curr_x;
+    data.y[lane] = state.curr_y;
+    data.active[lane] = l.has_active_piece ? 0xFFFF : 0;
+    if (l.has_active_piece) renderPiece(lane);
+    else clearPiece(lane);
+}
+
+template<int K>
+GameState BoardBatch<K>::getLaneState(int lane) const {
+    GameState state;
+    for (int y = 0; y < Height; y++) {
+        for (int x = 0; x < Width; x++) {
+            int type = 0;
+            for (int p = 0; p < Board::TypePlanes; p++) {
+                type |= ((data.planes[p][y][lane] >> x) & 1) << p;
+            }
+            state.board.setCell(x, y, (data.rows[y][lane] >> x) & 1, static_cast<TrashType>(type));
+        }
+    }
+
+    const LaneInfo &l = info[lane];
+    state.rng = l.rng;
+    state.score = l.score;
+    state.level = l.level;
+    state.lines_cleared = l.lines_cleared;
+    state.combo_count = l.combo_count;
+    state.pieces_placed = l.pieces_placed;
+    for (int i = 0; i < 5; i++) {
+        state.recycled_count[i] = l.recycled_count[i];
+    }
+    state.curr_shape = l.curr_shape;
+    state.curr_rotation = l.curr_rotation;
+    state.curr_x = data.x[lane];
+    state.curr_y = data.y[lane];
+    state.next_shape = l.next_shape;
+    state.hold_shape = l.hold_shape;
+    for (int i = 0; i < 4; i++) {
+        state.curr_types[i] = l.curr_type;
+        state.next_types[i] = l.next_type;
+        state.hold_types[i] = l.hold_types[i];
+    }
+    state.has_active_piece = l.has_active_piece;
+    state.can_hold = l.can_hold;
+    state.game_over = l.game_over;
+    return state;
+}
+
+template<int K>
+void BoardBatch<K>::step(const uint8_t actions[K]){
+    int8_t rotations[K];
+
+    memcpy(data.actions, actions, sizeof(data.actions));
+    for (int lane = 0; lane < K; lane++) {
+        data.rotate[lane] = 0;
+        if (actions[lane] != BATCH_ROTATE || !data.active[lane]) continue;
+
+        // A peça girada é desenhada aqui; o kernel só testa a sobreposição
+        const LaneInfo &l = info[lane];
+        int rotation = l.curr_rotation > 0 ? l.curr_rotation - 1 : 3;
+        const PieceMask &m = pieceMask(l.curr_shape, rotation);
+        int x = data.x[lane];
+        int y = data.y[lane];
+        if (x + m.min_dx >= 0 && x + m.max_dx < Width && y + m.min_dy >= 0 && y + m.max_dy < Height) {
+            for (int r = 0; r < Height; r++) {
+                data.candidate[r][lane] = 0;
+            }
+            for (int r = 0; r < m.height; r++) {
+                data.candidate[y + m.min_dy + r][lane] = (uint16_t)(m.rows[r] << (x + m.min_dx));
+            }
+            data.rotate[lane] = 0xFFFF;
+            rotations[lane] = rotation;
+        }
+    }
+
+    step_kernel(data);
+
+    uint8_t locked_lanes[K];
+    int locked_count = 0;
+    int passes = 0;
+    for (int lane = 0; lane < K; lane++) {
+        if (data.rotate[lane]) info[lane].curr_rotation = rotations[lane];
+        if (data.locked[lane]) locked_lanes[locked_count++] = lane;
+    }
+    if (locked_count == 0) return;
+
+    for (int pass = 0; pass < 4; pass++) {
+        for (int lane = 0; lane < K; lane++) {
+            data.clear_row[pass][lane] = Height;
+        }
+    }
+    for (int i = 0; i < locked_count; i++) {
+        int lane = locked_lanes[i];
+        int16_t clear_rows[4] = {Height, Height, Height, Height};
+        int count = lockLane(lane, clear_rows);
+        if (count > passes) passes = count;
+        for (int pass = 0; pass < count; pass++) {
+            data.clear_row[pass][lane] = clear_rows[pass];
+        }
+    }
+    if (passes > 0) compact_kernel(data, passes);
+
+    for (int i = 0; i < locked_count; i++) {
+        spawn(locked_lanes[i]);
+    }
+}
+
+template<int K>
+bool BoardBatch<K>::collides(int lane, int shape, int rotation, int x, int y) const {
+    const PieceMask &m = pieceMask(shape, rotation);
+    int left = x + m.min_dx;
+    int bottom = y + m.min_dy;
+    if (left < 0 || x + m.max_dx >= Width || bottom < 0 || y + m.max_dy >= Height) {
+        return true;
+    }
+    uint16_t hit = 0;
+    for (int r = 0; r < m.height; r++) {
+        hit |= data.rows[bottom + r][lane] & (uint16_t)(m.rows[r] << left);
+    }
+    return hit != 0;
+}
+
+template<int K>
+void BoardBatch<K>::clearPiece(int lane){
+    for (int r = 0; r < Height; r++) {
+        data.piece[r][lane] = 0;
+    }
+}
+
+template<int K>
+void BoardBatch<K>::renderPiece(int lane){
+    const LaneInfo &l = info[lane];
+    const PieceMask &m = pieceMask(l.curr_shape, l.curr_rotation);
+    int x = data.x[lane];
+    int y = data.y[lane];
+
+    clearPiece(lane);
+    for (int r = 0; r < m.height; r++) {
+        data.piece[y + m.min_dy + r][lane] = (uint16_t)(m.rows[r] << (x + m.min_dx));
+    }
+    for (int p = 0; p < Board::TypePlanes; p++) {
+        data.type_bits[p][lane] = (l.curr_type >> p) & 1 ? 0xFFFF : 0;
+    }
+}
+
+// Linha cheia cujos planos de tipo são todos vazios ou todos cheios
+template<int K>
+bool BoardBatch<K>::isUniformRow(int lane, int y, TrashType &type) const {
+    if (data.rows[y][lane] != Board::FullRow) return false;
+
+    int t = 0;
+    for (int p = 0; p < Board::TypePlanes; p++) {
+        uint16_t plane = data.planes[p][y][lane];
+        if (plane == Board::FullRow) t |= 1 << p;
+        else if (plane != 0) return false;
+    }
+    if (t >= NONE) return false;
+    type = static_cast<TrashType>(t);
+    return true;
+}
+
+template<int K>
+void BoardBatch<K>::generateNextPiece(int lane){
+    LaneInfo &l = info[lane];
+    l.next_shape = l.rng.below(7);
+    l.next_type = l.rng.below(5);
+}
+
+// Mesma ordem de sorteios de Game::spawnTrashes
+template<int K>
+void BoardBatch<K>::spawn(int lane){
+    LaneInfo &l = info[lane];
+    l.curr_shape = l.next_shape;
+    l.curr_type = l.next_type;
+    generateNextPiece(lane);
+
+    int rotation = l.rng.below(4);
+    int position = l.rng.below(5) + spawnMinX(Width);
+
+    l.curr_rotation = rotation;
+    if (collides(lane, l.curr_shape, rotation, position, spawnY(Height))) {
+        l.game_over = true;
+        l.has_active_piece = false;
+        data.active[lane] = 0;
+        clearPiece(lane);
+    }
+    else {
+        data.x[lane] = position;
+        data.y[lane] = spawnY(Height);
+        l.can_hold = true;
+        l.has_active_piece = true;
+        data.active[lane] = 0xFFFF;
+        renderPiece(lane);
+    }
+}
+
+// O kernel já gravou a peça no tabuleiro; aqui fica o resto de
+// Game::freezeCurrent e Game::checkMultipleLines. Todas as linhas cheias vão
+// para clear_rows (da mais alta para a mais baixa) e saem na compactação
+// vetorial; as uniformes também pontuam.
+template<int K>
+int BoardBatch<K>::lockLane(int lane, int16_t clear_rows[4]){
+    LaneInfo &l = info[lane];
+    l.has_active_piece = false;
+    l.pieces_placed++;
+
+    const PieceMask &m = pieceMask(l.curr_shape, l.curr_rotation);
+    int first_row = data.y[lane] + m.min_dy;
+    int last_row = data.y[lane] + m.max_dy;
+
+    TrashType line_types[4];
+    int uniform_count = 0;
+    uint32_t full_rows = 0;
+    for (int y = first_row; y <= last_row; y++) {
+        if (data.rows[y][lane] != Board::FullRow) continue;
+
+        full_rows |= 1u << y;
+        TrashType type;
+        if (isUniformRow(lane, y, type)) {
+            line_types[uniform_count++] = type;
+        }
+    }
+
+    int count = 0;
+    for (uint32_t rows = full_rows; rows; rows &= ~(1u << highestBit(rows))) {
+        clear_rows[count++] = highestBit(rows);
+    }
+
+    if (uniform_count > 0) {
+        if (uniform_count > 1) {
+            l.combo_count++;
+        } else {
+            l.combo_count = 0;
+        }
+
+        for (int i = 0; i < uniform_count; i++) {
+            updateScore(lane, line_types[i], i > 0 || l.combo_count > 0);
+            l.recycled_count[line_types[i]]++;
+        }
+
+        l.lines_cleared += uniform_count;
+        int new_level = levelForLines(rules, l.lines_cleared);
+        if (new_level > l.level) {
+            l.level = new_level;
+        }
+    } else {
+        l.combo_count = 0;
+    }
+    return count;
+}
+
+template<int K>
+void BoardBatch<K>::updateScore(int lane, TrashType type, bool is_combo){
+    LaneInfo &l = info[lane];
+    l.score += recyclePoints(rules, type, 1, l.level, l.combo_count, is_combo);
+}
+
+template class BoardBatch<8>;
+template class BoardBatch<16>;
+template class BoardBatch<32>;
@@ -0,0 +1,144 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <stdint.h>
+#include "game.hpp"
+
+// Ação de uma lane em um passo, com a mesma semântica do método de Game
+enum BatchAction {
+    BATCH_NONE,      // Nada acontece
+    BATCH_LEFT,      // translate(-1)
+    BATCH_RIGHT,     // translate(1)
+    BATCH_ROTATE,    // rotate()
+    BATCH_DOWN,      // moveDown()
+    BATCH_HARD_DROP  // hardDrop()
+};
+
+// Conjunto de instruções dos kernels do lote
+enum BatchIsa {BATCH_SCALAR, BATCH_SSE2, BATCH_AVX2};
+
+// Melhor conjunto suportado pela CPU em que o programa está rodando
+BatchIsa bestBatchIsa();
+const char *getBatchIsaName(BatchIsa isa);
+
+// Dados intercalados de K tabuleiros 10x20 (struct-of-arrays): o elemento
+// [y][lane] de cada vetor é a linha y daquela lane, então uma mesma linha de
+// todas as lanes fica contígua e cabe em um registrador SIMD.
+// A peça ativa também é guardada como bitmask por linha, de modo que mover,
+// testar colisão e travar são operações de vetor iguais em todas as lanes.
+template<int K>
+struct BatchLanes {
+    static_assert(K == 8 || K == 16 || K == 32, "o lote suporta K = 8, 16 ou 32");
+    static const int Height = Board::Height;
+    static const int TypePlanes = Board::TypePlanes;
+
+    alignas(64) uint16_t rows[Height][K];
+    alignas(64) uint16_t planes[TypePlanes][Height][K];
+    alignas(64) uint16_t piece[Height][K];     // Peça ativa (zero se não houver)
+    alignas(64) uint16_t candidate[Height][K]; // Peça girada, testada pelo rotate
+    alignas(64) uint16_t type_bits[TypePlanes][K]; // 0xFFFF se o bit p do tipo da peça está ligado
+    alignas(64) int16_t x[K];
+    alignas(64) int16_t y[K];
+
+    // Entrada do passo: ação de cada lane e máscara (0 ou 0xFFFF) das lanes
+    // com peça ativa. rotate chega marcado nas lanes cuja peça girada cabe no
+    // tabuleiro; o kernel deixa marcadas só as que giraram e marca em locked
+    // as que travaram a peça.
+    alignas(64) uint8_t actions[K];
+    alignas(64) uint16_t active[K];
+    alignas(64) uint16_t rotate[K];
+    alignas(64) uint16_t locked[K];
+
+    // Linhas a remover em cada passada da compactação, da mais alta para a
+    // mais baixa (Height = nenhuma)
+    alignas(64) int16_t clear_row[4][K];
+};
+
+// Motor em lote: K partidas avançam juntas, uma ação por lane a cada passo.
+// Movimento, colisão, trava e remoção de linhas rodam nos kernels SIMD
+// (AVX2, SSE2 ou escalar, escolhidos em tempo de execução); o que depende de
+// cada lane (sorteio de peças, pontuação) segue a mesma ordem de Game, então
+// uma lane reproduz uma partida de Game com a mesma semente e as mesmas ações.
+// Não há hold nem efeitos visuais, e a peça ativa tem um único tipo (como as
+// geradas por Game).
+template<int K>
+class BoardBatch{
+    public:
+        static const int Lanes = K;
+        static const int Width = Board::Width;
+        static const int Height = Board::Height;
+
+        explicit BoardBatch(BatchIsa isa = bestBatchIsa());
+
+        BatchIsa getIsa() const { return isa; }
+
+        // Regras de pontuação, as mesmas para todas as lanes
+        const RulesConfig &getRules() const { return rules; }
+        void setRules(const RulesConfig &new_rules) { rules = new_rules; }
+
+        // Igual a Game::seed(seed_value) seguido de Game::restart()
+        void reset(int lane, uint64_t seed_value);
+
+        // Troca de estado com Game
+        void setLaneState(int lane, const GameState &state);
+        GameState getLaneState(int lane) const;
+
+        // Aplica actions[lane] (um BatchAction) a todas as lanes
+        void step(const uint8_t actions[K]);
+
+        bool getGameOver(int lane) const { return info[lane].game_over; }
+        bool hasActivePiece(int lane) const { return info[lane].has_active_piece; }
+        int getScore(int lane) const { return info[lane].score; }
+        int getLevel(int lane) const { return info[lane].level; }
+        int getLinesCleared(int lane) const { return info[lane].lines_cleared; }
+        int getComboCount(int lane) const { return info[lane].combo_count; }
+        int getPiecesPlaced(int lane) const { return info[lane].pieces_placed; }
+        int getRecycledCount(int lane, TrashType type) const { return info[lane].recycled_count[type]; }
+        int getCurrentShape(int lane) const { return info[lane].curr_shape; }
+        int getCurrentRotation(int lane) const { return info[lane].curr_rotation; }
+        int getCurrentX(int lane) const { return data.x[lane]; }
+        int getCurrentY(int lane) const { return data.y[lane]; }
+        uint16_t getRow(int lane, int y) const { return data.rows[y][lane]; }
+
+    private:
+        // Estado escalar de cada lane, no mesmo formato de Game
+        struct LaneInfo {
+            Rng rng;
+            int32_t score;
+            int32_t level;
+            int32_t lines_cleared;
+            int32_t combo_count;
+            int32_t pieces_placed;
+            int32_t recycled_count[5];
+            int8_t curr_shape, curr_rotation;
+            int8_t next_shape, hold_shape;
+            uint8_t curr_type, next_type;
+            uint8_t hold_types[4];
+            bool has_active_piece, can_hold, game_over;
+        };
+
+        typedef void (*StepKernel)(BatchLanes<K> &lanes);
+        typedef void (*CompactKernel)(BatchLanes<K> &lanes, int passes);
+
+        bool collides(int lane, int shape, int rotation, int x, int y) const;
+        void renderPiece(int lane);
+        void clearPiece(int lane);
+        bool isUniformRow(int lane, int y, TrashType &type) const;
+        void spawn(int lane);
+        void generateNextPiece(int lane);
+        int lockLane(int lane, int16_t clear_rows[4]);
+        void updateScore(int lane, TrashType type, bool is_combo);
+
+        BatchIsa isa;
+        RulesConfig rules;
+        StepKernel step_kernel;
+        CompactKernel compact_kernel;
+        BatchLanes<K> data;
+        LaneInfo info[K];
+};
+
+extern template class BoardBatch<8>;
+extern template class BoardBatch<16>;
+extern template class BoardBatch<32>;
+
+#endif // BATCH_HPP
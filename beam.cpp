@@ -0,0 +1,206 @@
+#include "beam.hpp"
+#include <algorithm>
+#include <string.h>
+
+// Domínio das chaves de pontuação, separado das chaves do Game
+static const uint64_t ZOBRIST_SCORE = 4ULL << 40;
+
+BeamPlanner::BeamPlanner(int threads, const AutoWeights &weights) : weights(weights) {
+    if (threads != 1) pool.reset(new ThreadPool(threads));
+    for (int i = 0; i < getThreadCount(); i++) {
+        arenas.push_back(std::unique_ptr<Arena>(new Arena()));
+    }
+}
+
+Move BeamPlanner::plan(const Game &game, int budget_us){
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = budget_us > 0 ? start + std::chrono::microseconds(budget_us)
+                                               : Clock::time_point::max();
+    last_width = 0;
+    last_nodes = 0;
+    last_hits = 0;
+    EvalWeights eval_weights = toEvalWeights(weights, game.getRules());
+    for (size_t i = 0; i < arenas.size(); i++) {
+        arenas[i]->hits = 0;
+        arenas[i]->evaluator.setWeights(eval_weights);
+    }
+
+    // O termo uniforme depende das pontuações base
+    if (memcmp(&table_rules, &game.getRules(), sizeof(RulesConfig)) != 0) {
+        table.clear();
+        table_rules = game.getRules();
+    }
+
+    // Sem busca completa, a peça cai onde está
+    Move best = {(int8_t)game.getCurrentRotation(), (int8_t)game.getCurrentX(), (int8_t)game.getCurrentY(), false};
+    if (game.hasActivePiece()) best.y = (int8_t)game.landingRow();
+
+    arenas[0]->generator.generate(game, root_moves, game.canHold());
+    for (int beam_width = width; !root_moves.empty(); beam_width *= 2) {
+        Clock::time_point round_start = Clock::now();
+        int first = 0;
+        bool saturated = false;
+        if (!search(game, beam_width, deadline, first, saturated)) break;
+        best = root_moves[first];
+        last_width = beam_width;
+
+        // Outra rodada só se ela mudar algo e se couber no prazo (o dobro
+        // da largura custa cerca do dobro do tempo)
+        Clock::time_point now = Clock::now();
+        if (budget_us <= 0 || saturated || beam_width * 2 > MAX_WIDTH) break;
+        if (deadline - now < 2 * (now - round_start)) break;
+    }
+
+    for (size_t i = 0; i < arenas.size(); i++) last_hits += arenas[i]->hits;
+    last_micros = (int)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    return best;
+}
+
+bool BeamPlanner::search(const Game &root, int beam_width, Clock::time_point deadline, int &best_first,
+                         bool &saturated){
+    int root_score = root.getScore();
+    expired = false;
+    saturated = true;
+    table.newSearch();
+
+    // Depois da próxima peça, um futuro sorteado só com o que está à vista
+    Game &sampled = arenas[0]->game;
+    sampled.restore(root.snapshot());
+    sampled.seed((uint64_t)root.getPiecesPlaced() << 32 | (uint32_t)root.getScore());
+
+    beam.clear();
+    beam.push_back(Node{sampled.snapshot(), 0.0, 0, -1, 0});
+    for (int level = 0; level < depth; level++) {
+        if (children.size() < beam.size()) children.resize(beam.size());
+
+        if (pool) {
+            for (size_t i = 0; i < beam.size(); i++) {
+                pool->submit([this, i, root_score, level, deadline](int worker) {
+                    expand(*arenas[worker], beam[i], root_score, level, children[i], deadline);
+                });
+            }
+            pool->wait();
+        }
+        else {
+            for (size_t i = 0; i < beam.size(); i++) {
+                expand(*arenas[0], beam[i], root_score, level, children[i], deadline);
+            }
+        }
+        if (expired) return false;
+
+        // Os filhos na ordem dos pais: empates decididos pela posição, então
+        // a escolha não depende de qual thread expandiu cada pai
+        candidates.clear();
+        for (size_t i = 0; i < beam.size(); i++) {
+            for (size_t c = 0; c < children[i].size(); c++) {
+                candidates.push_back(Candidate{children[i][c].value, (int)i, (int)c});
+            }
+        }
+        last_nodes += candidates.size();
+        if (candidates.empty()) break; // Só game overs: vale o nível anterior
+
+        auto better = [](const Candidate &a, const Candidate &b) {
+            if (a.value != b.value) return a.value > b.value;
+            if (a.parent != b.parent) return a.parent < b.parent;
+            return a.child < b.child;
+        };
+        std::vector<Node> next;
+        if (level == depth - 1) {
+            // No último nível só o melhor interessa
+            std::partial_sort(candidates.begin(), candidates.begin() + 1, candidates.end(), better);
+            next.push_back(children[candidates[0].parent][candidates[0].child]);
+        }
+        else {
+            // Em ordem de valor, a primeira cópia de cada estado repetido
+            // fica e as outras saem; a ordem não depende das threads
+            std::sort(candidates.begin(), candidates.end(), better);
+            seen.clear();
+            size_t k = 0;
+            for (; k < candidates.size() && (int)next.size() < beam_width; k++) {
+                const Node &child = children[candidates[k].parent][candidates[k].child];
+                if (seen.insert(child.key).second) next.push_back(child);
+            }
+            if (k < candidates.size()) saturated = false;
+        }
+        beam.swap(next);
+        best_first = beam[0].first;
+    }
+    return true;
+}
+
+void BeamPlanner::expand(Arena &arena, const Node &parent, int root_score, int level,
+                         std::vector<Node> &out, Clock::time_point deadline){
+    out.clear();
+    arena.pending.clear();
+    arena.pending_hashes.clear();
+    if (expired.load(std::memory_order_relaxed)) return;
+
+    arena.game.restore(parent.state);
+    bool hold_empty = arena.game.getHoldShape() < 0;
+    bool visible_only = level < VISIBLE_PIECES;
+    arena.generator.generate(arena.game, arena.moves, arena.game.canHold());
+    for (size_t i = 0; i < arena.moves.size(); i++) {
+        if ((i & 7) == 0 && Clock::now() >= deadline) {
+            expired = true;
+            return;
+        }
+
+        // Posição na fila da peça jogada (-1: a do hold, sempre à vista). Um
+        // hold com o espaço vazio joga a seguinte da fila.
+        const Move &move = arena.moves[i];
+        int placed = move.hold ? (hold_empty ? parent.queue + 1 : -1) : parent.queue;
+        if (visible_only && placed >= VISIBLE_PIECES) continue;
+
+        arena.game.restore(parent.state);
+        MoveGenerator::apply(arena.game, move);
+        uint64_t hash = arena.game.getHash();
+
+        // Mesma conta de evaluateBoard, com a parte da posição vinda da
+        // tabela ou, depois do laço, do lote. Ela só depende do tabuleiro,
+        // então a chave é o hash dele: o mesmo tabuleiro com outras peças
+        // na mão (outra ordem de jogadas, outro uso do hold) também acerta.
+        double value = -1e9;
+        if (!arena.game.getGameOver()) {
+            TranspositionTable::Entry entry;
+            uint64_t board_hash = arena.game.getBoardHash();
+            if (table.probe(board_hash, entry)) {
+                value = entry.value + weights.score * (arena.game.getScore() - root_score);
+                arena.hits++;
+            }
+            else {
+                arena.pending.push_back((int)out.size());
+                arena.pending_hashes.push_back(board_hash);
+            }
+        }
+        uint64_t key = hash ^ zobristKey(ZOBRIST_SCORE + (uint32_t)arena.game.getScore());
+        int queue = parent.queue + (move.hold && hold_empty ? 2 : 1);
+        out.push_back(Node{arena.game.snapshot(), value, key, parent.first < 0 ? (int)i : parent.first, queue});
+    }
+
+    // Com out completo, os endereços dos tabuleiros não mudam mais
+    size_t count = arena.pending.size();
+    arena.views.clear();
+    for (size_t k = 0; k < count; k++) {
+        arena.views.push_back(BoardView(out[arena.pending[k]].state.board));
+    }
+    arena.values.resize(count);
+    arena.evaluator.evaluate(arena.views.data(), (int)count, arena.values.data());
+    for (size_t k = 0; k < count; k++) {
+        Node &child = out[arena.pending[k]];
+        // Avaliação estática: profundidade 0, então a entrada nova sempre
+        // substitui a que colidir
+        table.store(arena.pending_hashes[k], arena.values[k], 0);
+        child.value = arena.values[k] + weights.score * (child.state.score - root_score);
+    }
+}
+
+Placement BeamPlanner::choose(const Game &game){
+    Move move = plan(game);
+    Placement placement = {move.rotation, move.x, move.hold};
+    return placement;
+}
+
+void BeamPlanner::play(Game &game){
+    if (!game.hasActivePiece()) return;
+    MoveGenerator::apply(game, plan(game));
+}
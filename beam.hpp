@@ -0,0 +1,147 @@
+#ifndef BEAM_HPP
+#define BEAM_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include "autoplayer.hpp"
+#include "evaluator.hpp"
+#include "game.hpp"
+#include "movegen.hpp"
+#include "policy.hpp"
+#include "thread_pool.hpp"
+#include "transposition.hpp"
+
+// Planejador em feixe: expande as posições finais da peça atual, depois as
+// da próxima (com os ramos de hold em cada nível) e mantém só os width
+// melhores estados por profundidade. A expansão de cada estado do feixe é
+// uma tarefa do ThreadPool, com arenas por thread; os filhos vão para o
+// índice do pai, então o resultado não depende do número de threads.
+//
+// Com orçamento de tempo, a busca é repetida dobrando a largura enquanto
+// couber outra rodada: quanto mais núcleos, mais largo o feixe no mesmo
+// tempo. Vale a primeira jogada da busca mais larga que terminou.
+//
+// As posições novas de cada pai são avaliadas em lotes pelo
+// BoardEvaluator. Os valores ficam numa tabela de transposição
+// compartilhada pelas threads, indexada só pelo tabuleiro: o mesmo
+// tabuleiro alcançado por outra ordem de jogadas, com outras peças na mão
+// (ou na rodada seguinte, mais larga), não é avaliado de novo. Estados
+// repetidos num mesmo nível entram no feixe uma vez só.
+//
+// Nos dois primeiros níveis só entram peças que o jogador vê: a atual, a
+// próxima e a do hold. Um hold com o espaço vazio puxa a peça seguinte da
+// fila, então ali ele só vale se essa peça estiver à vista; depois de um
+// hold desses na raiz, o nível seguinte só pode jogar a peça guardada. Mais
+// fundo, as peças saem de um gerador ressemeado só com o que está à vista
+// (peças jogadas e pontuação): um futuro plausível, não o sorteado pela
+// partida.
+class BeamPlanner : public Policy{
+    public:
+        static const int DEFAULT_DEPTH = 2;
+        static const int DEFAULT_WIDTH = 16;
+        static const int MAX_WIDTH = 4096;
+        static const int VISIBLE_PIECES = 2; // Atual e próxima; o hold também está à vista
+
+        // threads <= 0 usa todos os núcleos; com 1 a busca roda na thread
+        // de quem chama
+        explicit BeamPlanner(int threads = 0, const AutoWeights &weights = AutoWeights());
+
+        int getThreadCount() const { return pool ? pool->getThreadCount() : 1; }
+
+        void setDepth(int new_depth) { depth = new_depth < 1 ? 1 : new_depth; }
+        int getDepth() const { return depth; }
+
+        // Largura da primeira rodada (e da única, sem orçamento)
+        void setWidth(int new_width) { width = new_width < 1 ? 1 : new_width; }
+        int getWidth() const { return width; }
+
+        const AutoWeights &getWeights() const { return weights; }
+        void setWeights(const AutoWeights &new_weights) { weights = new_weights; table.clear(); }
+
+        // Melhor primeira jogada para a peça atual. budget_us 0 = uma rodada
+        // só, com a largura inicial (resultado reprodutível).
+        Move plan(const Game &game, int budget_us = 0);
+
+        // Orçamento para uma peça que desce uma linha a cada interval_us:
+        // a decisão sai bem antes da próxima queda
+        static int budgetForGravity(int interval_us) { return interval_us / 4; }
+
+        // Como Policy: uma rodada por peça, sem orçamento
+        Placement choose(const Game &game);
+        void play(Game &game);
+
+        // Estatísticas do último plan: largura da rodada usada, estados
+        // avaliados em todas as rodadas (e quantos vieram da tabela de
+        // transposição) e tempo total
+        int getLastWidth() const { return last_width; }
+        long getLastNodes() const { return last_nodes; }
+        long getLastHits() const { return last_hits; }
+        int getLastMicros() const { return last_micros; }
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Node {
+            GameState state;
+            double value;
+            uint64_t key; // Hash da posição com a pontuação, para tirar repetidos
+            int first;    // Índice da primeira jogada em root_moves (-1 na raiz)
+            int queue;    // Posição da peça atual na fila vista na raiz (0 atual, 1 próxima)
+        };
+
+        // Alinhada à linha de cache para threads vizinhas não disputarem a mesma
+        struct alignas(64) Arena {
+            MoveGenerator generator;
+            std::vector<Move> moves;
+            Game game;
+            long hits = 0;
+
+            // Filhos fora da tabela de transposição, avaliados em lote
+            BoardEvaluator evaluator;
+            std::vector<int> pending;
+            std::vector<uint64_t> pending_hashes;
+            std::vector<BoardView> views;
+            std::vector<double> values;
+        };
+
+        // Filho de algum estado do feixe, para ordenar sem copiar estados
+        struct Candidate {
+            double value;
+            int parent, child;
+        };
+
+        // Uma rodada com essa largura; false se o prazo acabou antes do fim.
+        // saturated indica que nenhum nível antes do último precisou
+        // descartar estados: uma rodada mais larga daria o mesmo resultado.
+        bool search(const Game &root, int beam_width, Clock::time_point deadline, int &best_first,
+                    bool &saturated);
+        void expand(Arena &arena, const Node &parent, int root_score, int level,
+                    std::vector<Node> &out, Clock::time_point deadline);
+
+        AutoWeights weights;
+        int depth = DEFAULT_DEPTH;
+        int width = DEFAULT_WIDTH;
+        int last_width = 0;
+        long last_nodes = 0;
+        long last_hits = 0;
+        int last_micros = 0;
+
+        std::unique_ptr<ThreadPool> pool;
+        std::vector<std::unique_ptr<Arena>> arenas;
+        std::vector<Move> root_moves;
+        std::vector<Node> beam;
+        std::vector<std::vector<Node>> children; // Filhos de cada estado do feixe
+        std::vector<Candidate> candidates;
+        std::unordered_set<uint64_t> seen;
+        std::atomic<bool> expired{false};
+
+        // Valores de evaluatePosition pelo hash do tabuleiro; valem enquanto
+        // os pesos e as regras forem os mesmos
+        TranspositionTable table;
+        RulesConfig table_rules;
+};
+
+#endif // BEAM_HPP
@@ -0,0 +1,345 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "pieces.hpp"
+
+// Enum dos tipos de lixo para reciclagem
+enum TrashType {PAPER, PLASTIC, METAL, GLASS, ORGANIC, NONE};
+
+// Menor palavra sem sinal com pelo menos Bits bits (até 64). Usada para a
+// máscara de cada linha (um bit por coluna) e de cada coluna (um bit por linha).
+template<int Bits>
+struct MaskWord {
+    static_assert(Bits >= 1 && Bits <= 64, "máscaras do tabuleiro têm no máximo 64 bits");
+    typedef typename std::conditional<(Bits <= 16), uint16_t,
+            typename std::conditional<(Bits <= 32), uint32_t, uint64_t>::type>::type type;
+};
+
+// Operações de bits válidas para qualquer largura de máscara
+constexpr uint64_t lowBits(int n){
+    return n >= 64 ? ~0ULL : (1ULL << n) - 1;
+}
+
+inline int bitCount(uint64_t v) { return __builtin_popcountll(v); }
+inline int lowestBit(uint64_t v) { return __builtin_ctzll(v); }
+inline int highestBit(uint64_t v) { return 63 - __builtin_clzll(v); }
+
+// Chave de Zobrist de um índice: splitmix64 calculado na hora, no lugar de
+// uma tabela sorteada. Cada tamanho de tabuleiro tem suas chaves sem
+// ocupar memória, e o mesmo estado tem o mesmo hash em qualquer processo.
+constexpr uint64_t zobristKey(uint64_t index){
+    uint64_t z = (index + 1) * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Núcleo do tabuleiro em bitboard.
+// A ocupação fica em uma máscara por linha e o TrashType de cada célula é
+// guardado em três planos de bits por linha (bit p do tipo no plano p).
+// Colisão, detecção de linha cheia/uniforme e remoção de linha viram
+// operações sobre palavras em vez de laços célula a célula.
+// Índices derivados (altura de cada coluna, células preenchidas por linha e
+// histograma de tipos por linha) são mantidos a cada escrita e remoção,
+// assim como o hash de Zobrist das células ocupadas e seus tipos.
+// As dimensões são parâmetros de template: os laços têm limites constantes
+// e cada linha usa a menor palavra que comporta a largura.
+template<int W, int H>
+class BasicBoard{
+    public:
+        static const int Width = W;
+        static const int Height = H;
+        static const int TypePlanes = 3;
+        static const int TypeCount = NONE + 1;
+
+        // Bit x = coluna x de uma linha
+        typedef typename MaskWord<W>::type RowMask;
+        // Bit y = linha y de uma coluna ou de um conjunto de linhas
+        typedef typename MaskWord<H>::type ColumnMask;
+
+        static const RowMask FullRow = (RowMask)lowBits(W);
+
+        BasicBoard() { clear(); }
+
+        void clear(){
+            memset(rows, 0, sizeof(rows));
+            memset(planes, 0, sizeof(planes));
+            memset(cols, 0, sizeof(cols));
+            memset(heights, 0, sizeof(heights));
+            memset(fill, 0, sizeof(fill));
+            memset(type_counts, 0, sizeof(type_counts));
+            hash = 0;
+        }
+
+        // Hash de Zobrist do tabuleiro: XOR das chaves (x, y, tipo) das
+        // células ocupadas; células vazias não contam
+        uint64_t getHash() const { return hash; }
+        static uint64_t cellKey(int x, int y, TrashType type){
+            return zobristKey(((uint64_t)y * Width + x) * TypeCount + type);
+        }
+
+        RowMask getRow(int y) const { return rows[y]; }
+        const RowMask *getRows() const { return rows; }
+        const RowMask *getTypePlane(int p) const { return planes[p]; }
+
+        // Ocupação transposta: bit y da coluna x
+        ColumnMask getColumn(int x) const { return cols[x]; }
+
+        // Linha acima do bloco mais alto da coluna (0 se vazia)
+        int getColumnHeight(int x) const { return heights[x]; }
+        int getRowFill(int y) const { return fill[y]; }
+        int getRowTypeCount(int y, TrashType type) const { return type_counts[y][type]; }
+
+        // Células vazias com algum bloco acima na mesma coluna
+        int countHoles() const {
+            int holes = 0;
+            for(int x = 0; x < Width; x++){
+                holes += heights[x] - bitCount(cols[x]);
+            }
+            return holes;
+        }
+
+        bool isOccupied(int x, int y) const {
+            return (rows[y] >> x) & 1;
+        }
+
+        TrashType getType(int x, int y) const {
+            int type = 0;
+            for(int p = 0; p < TypePlanes; p++){
+                type |= (int)((planes[p][y] >> x) & 1) << p;
+            }
+            return static_cast<TrashType>(type);
+        }
+
+        // Escreve apenas o tipo da célula, sem alterar a ocupação
+        void setType(int x, int y, TrashType type){
+            if(isOccupied(x, y)){
+                TrashType old_type = getType(x, y);
+                type_counts[y][old_type]--;
+                type_counts[y][type]++;
+                hash ^= cellKey(x, y, old_type) ^ cellKey(x, y, type);
+            }
+            writeType(x, y, type);
+        }
+
+        void setCell(int x, int y, bool occupied, TrashType type){
+            RowMask bit = (RowMask)((RowMask)1 << x);
+            ColumnMask column_bit = (ColumnMask)((ColumnMask)1 << y);
+            bool was_occupied = isOccupied(x, y);
+            if(was_occupied){
+                TrashType old_type = getType(x, y);
+                fill[y]--;
+                type_counts[y][old_type]--;
+                hash ^= cellKey(x, y, old_type);
+            }
+            if(occupied){
+                hash ^= cellKey(x, y, type);
+                rows[y] |= bit;
+                cols[x] |= column_bit;
+                fill[y]++;
+                type_counts[y][type]++;
+                if(y + 1 > heights[x]) heights[x] = y + 1;
+            }
+            else{
+                rows[y] &= (RowMask)~bit;
+                cols[x] &= (ColumnMask)~column_bit;
+                if(was_occupied) heights[x] = columnHeight(cols[x]);
+            }
+            writeType(x, y, type);
+        }
+
+        // True se a peça, com a âncora em (x, y), sair do tabuleiro ou
+        // sobrepor alguma célula ocupada: um AND deslocado por linha da peça
+        bool collides(const PieceMask &piece, int x, int y) const {
+            int left = x + piece.min_dx;
+            int bottom = y + piece.min_dy;
+            if(left < 0 || x + piece.max_dx >= Width || bottom < 0 || y + piece.max_dy >= Height){
+                return true;
+            }
+            RowMask hit = 0;
+            for(int r = 0; r < piece.height; r++){
+                hit |= rows[bottom + r] & (RowMask)((RowMask)piece.rows[r] << left);
+            }
+            return hit != 0;
+        }
+
+        // True se a peça em (x, y) não puder descer mais uma linha
+        bool isLanded(const PieceMask &piece, int x, int y) const {
+            return collides(piece, x, y - 1);
+        }
+
+        // Quantas linhas a peça em (x, y) cai até pousar, calculado de uma
+        // vez pelas colunas: para cada coluna da peça, a distância entre a
+        // célula mais baixa dela e o bloco ocupado logo abaixo (ou o chão).
+        // Supõe que a peça em (x, y) não colide.
+        int dropDistance(const PieceMask &piece, int x, int y) const {
+            int left = x + piece.min_dx;
+            int bottom = y + piece.min_dy;
+            int drop = Height;
+            for(int c = 0; c < piece.width; c++){
+                int cell_y = bottom + piece.bottom[c];
+                uint64_t below = cols[left + c] & lowBits(cell_y);
+                int gap = below ? cell_y - highestBit(below) - 1 : cell_y;
+                if(gap < drop) drop = gap;
+            }
+            return drop;
+        }
+
+        bool isFull(int y) const { return rows[y] == FullRow; }
+
+        // Linha cheia com um único tipo, lido direto do histograma da linha
+        bool isUniform(int y, TrashType &type) const {
+            if(fill[y] != Width) return false;
+
+            for(int t = 0; t < NONE; t++){
+                if(type_counts[y][t] == Width){
+                    type = static_cast<TrashType>(t);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Máscara das linhas cheias entre first_row e last_row (bit y = linha y)
+        ColumnMask fullRows(int first_row, int last_row) const {
+            ColumnMask full = 0;
+            for(int y = first_row; y <= last_row; y++){
+                full |= (ColumnMask)((ColumnMask)(rows[y] == FullRow) << y);
+            }
+            return full;
+        }
+
+        // Remove de uma vez todas as linhas marcadas em cleared (bit y =
+        // linha y). Cada faixa contígua de linhas mantidas desce com um único
+        // memmove, então o tabuleiro acima é copiado uma vez só, não importa
+        // quantas linhas saiam. As chaves dependem da linha, então o hash é
+        // refeito a partir da primeira linha removida.
+        void clearRows(ColumnMask cleared){
+            if(!cleared) return;
+
+            int dst = lowestBit(cleared);
+            int first = dst;
+            hash ^= rowsHash(first, Height);
+            int src = dst;
+            while(src < Height){
+                while(src < Height && ((cleared >> src) & 1)) src++;
+                int end = src;
+                while(end < Height && !((cleared >> end) & 1)) end++;
+                moveRows(dst, src, end - src);
+                dst += end - src;
+                src = end;
+            }
+            int removed = Height - dst;
+            memset(&rows[dst], 0, removed * sizeof(RowMask));
+            for(int p = 0; p < TypePlanes; p++){
+                memset(&planes[p][dst], 0, removed * sizeof(RowMask));
+            }
+            memset(&fill[dst], 0, removed * sizeof(fill[0]));
+            memset(&type_counts[dst], 0, removed * sizeof(type_counts[0]));
+            hash ^= rowsHash(first, dst);
+
+            // Nas colunas, cada linha removida (de cima para baixo) some do bitmask
+            for(int x = 0; x < Width; x++){
+                uint64_t column = cols[x];
+                uint64_t bits = cleared;
+                while(bits){
+                    int y = highestBit(bits);
+                    uint64_t above = y < 63 ? (column >> (y + 1)) << y : 0;
+                    column = (column & lowBits(y)) | above;
+                    bits &= ~(1ULL << y);
+                }
+                cols[x] = (ColumnMask)column;
+                heights[x] = columnHeight(cols[x]);
+            }
+        }
+
+    private:
+        static int columnHeight(ColumnMask column){
+            return column ? highestBit(column) + 1 : 0;
+        }
+
+        // XOR das chaves das células ocupadas nas linhas [from, to)
+        uint64_t rowsHash(int from, int to) const {
+            uint64_t h = 0;
+            for(int y = from; y < to; y++){
+                uint64_t bits = rows[y];
+                while(bits){
+                    int x = lowestBit(bits);
+                    h ^= cellKey(x, y, getType(x, y));
+                    bits &= bits - 1;
+                }
+            }
+            return h;
+        }
+
+        void moveRows(int dst, int src, int count){
+            if(count <= 0 || dst == src) return;
+            memmove(&rows[dst], &rows[src], count * sizeof(RowMask));
+            for(int p = 0; p < TypePlanes; p++){
+                memmove(&planes[p][dst], &planes[p][src], count * sizeof(RowMask));
+            }
+            memmove(&fill[dst], &fill[src], count * sizeof(fill[0]));
+            memmove(&type_counts[dst], &type_counts[src], count * sizeof(type_counts[0]));
+        }
+
+        void writeType(int x, int y, TrashType type){
+            RowMask bit = (RowMask)((RowMask)1 << x);
+            for(int p = 0; p < TypePlanes; p++){
+                if((type >> p) & 1) planes[p][y] |= bit;
+                else planes[p][y] &= (RowMask)~bit;
+            }
+        }
+
+        RowMask rows[Height];
+        RowMask planes[TypePlanes][Height];
+        ColumnMask cols[Width];
+        uint8_t heights[Width];
+        uint8_t fill[Height];
+        uint8_t type_counts[Height][TypeCount];
+        uint64_t hash;
+};
+
+// Visão somente leitura, sem cópia, das linhas de um tabuleiro. Continua
+// válida enquanto o tabuleiro existir e reflete as mudanças feitas nele.
+template<int W, int H>
+class BasicBoardView{
+    public:
+        static const int Width = W;
+        static const int Height = H;
+        typedef typename BasicBoard<W, H>::RowMask RowMask;
+
+        explicit BasicBoardView(const BasicBoard<W, H> &board)
+            : rows(board.getRows()),
+              planes{board.getTypePlane(0), board.getTypePlane(1), board.getTypePlane(2)} {}
+
+        RowMask getRow(int y) const { return rows[y]; }
+        const RowMask *getRows() const { return rows; }
+        const RowMask *getTypePlane(int p) const { return planes[p]; }
+
+        bool isOccupied(int x, int y) const {
+            return (rows[y] >> x) & 1;
+        }
+
+        // Tipo de uma célula ocupada (NONE se vazia)
+        TrashType getType(int x, int y) const {
+            if(!isOccupied(x, y)) return NONE;
+            int type = 0;
+            for(int p = 0; p < BasicBoard<W, H>::TypePlanes; p++){
+                type |= (int)((planes[p][y] >> x) & 1) << p;
+            }
+            return static_cast<TrashType>(type);
+        }
+
+    private:
+        const RowMask *rows;
+        const RowMask *planes[BasicBoard<W, H>::TypePlanes];
+};
+
+// Tabuleiro clássico 10x20
+typedef BasicBoard<10, 20> Board;
+typedef BasicBoardView<10, 20> BoardView;
+
+#endif // BOARD_HPP
@@ -0,0 +1,196 @@
+#include "batch.hpp"
+#include "game.hpp"
+#include <stdio.h>
+
+// Verificação do BoardBatch (make check): cada lane recebe as mesmas ações
+// que um Game com a mesma semente e, a cada passo, o estado das duas tem de
+// ser igual. Metade das lanes começa com linhas de um só tipo (às vezes
+// misturadas) e um buraco comum sob uma peça I em pé, para forçar limpezas
+// de várias linhas; rodadas alternadas usam regras com um nível por linha.
+// Roda para cada largura do lote e cada conjunto de instruções da CPU.
+
+static const int STEPS = 5000;
+static const int ROUNDS = 4;
+
+// Diferença entre o retrato de uma lane e o do Game, ou NULL se iguais
+static const char *difference(const GameState &lane, const GameState &game)
+{
+    BoardView lane_view(lane.board), game_view(game.board);
+    for (int y = 0; y < Board::Height; y++)
+    {
+        if (lane_view.getRow(y) != game_view.getRow(y))
+            return "linhas";
+        for (int x = 0; x < Board::Width; x++)
+        {
+            if (lane_view.getType(x, y) != game_view.getType(x, y))
+                return "tipos";
+        }
+    }
+    if (lane.board.getHash() != game.board.getHash())
+        return "hash";
+
+    Rng lane_rng = lane.rng, game_rng = game.rng;
+    if (lane_rng.next() != game_rng.next())
+        return "gerador";
+
+    if (lane.score != game.score) return "score";
+    if (lane.level != game.level) return "level";
+    if (lane.lines_cleared != game.lines_cleared) return "lines_cleared";
+    if (lane.combo_count != game.combo_count) return "combo_count";
+    if (lane.pieces_placed != game.pieces_placed) return "pieces_placed";
+    for (int t = 0; t < 5; t++)
+    {
+        if (lane.recycled_count[t] != game.recycled_count[t])
+            return "recycled_count";
+    }
+    if (lane.has_active_piece != game.has_active_piece) return "has_active_piece";
+    if (lane.game_over != game.game_over) return "game_over";
+    if (lane.hold_shape != game.hold_shape || lane.can_hold != game.can_hold) return "hold";
+    if (lane.next_shape != game.next_shape || lane.next_types[0] != game.next_types[0])
+        return "próxima peça";
+    if (game.has_active_piece)
+    {
+        if (lane.curr_shape != game.curr_shape || lane.curr_rotation != game.curr_rotation
+            || lane.curr_x != game.curr_x || lane.curr_y != game.curr_y)
+            return "peça atual";
+        for (int i = 0; i < 4; i++)
+        {
+            if (lane.curr_types[i] != game.curr_types[i])
+                return "tipos da peça atual";
+        }
+    }
+    return NULL;
+}
+
+// Linhas de baixo com um buraco na mesma coluna e uma I em pé sobre ele
+static void prepareClear(Game &game, Rng &rng)
+{
+    int hole = rng.below(Board::Width);
+    TrashType type = (TrashType)rng.below(5);
+    int rows = 1 + rng.below(4);
+    for (int y = 0; y < rows; y++)
+    {
+        bool mixed = rng.below(3) == 0;
+        for (int x = 0; x < Board::Width; x++)
+        {
+            if (x == hole) continue;
+            TrashType cell = mixed && x == (hole + 1) % Board::Width ? (TrashType)((type + 1) % 5) : type;
+            game.setCell(x, y, true, cell, 0, 0, 0);
+        }
+    }
+    TrashType types[4] = {type, type, type, type};
+    game.setCurrentPiece(0, 1, hole, Board::Height - 5, types);
+}
+
+static uint8_t randomAction(Rng &rng)
+{
+    int roll = rng.below(24);
+    if (roll < 2) return BATCH_NONE;
+    if (roll < 6) return BATCH_LEFT;
+    if (roll < 10) return BATCH_RIGHT;
+    if (roll < 14) return BATCH_ROTATE;
+    if (roll < 22) return BATCH_DOWN;
+    return BATCH_HARD_DROP;
+}
+
+static void applyAction(Game &game, uint8_t action)
+{
+    switch (action)
+    {
+    case BATCH_LEFT: game.translate(-1); break;
+    case BATCH_RIGHT: game.translate(1); break;
+    case BATCH_ROTATE: game.rotate(); break;
+    case BATCH_DOWN: game.moveDown(); break;
+    case BATCH_HARD_DROP: game.hardDrop(); break;
+    }
+}
+
+// Número de divergências de um lote de K lanes nesse conjunto de instruções
+template<int K>
+static long checkLanes(BatchIsa isa)
+{
+    long mismatches = 0;
+    long lines = 0;
+    Rng rng(0xc4ec, K);
+    static Game games[K];
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        RulesConfig rules;
+        if (round % 2)
+            rules.lines_per_level = 1;
+
+        BoardBatch<K> batch(isa);
+        batch.setRules(rules);
+        uint64_t next_seed = (uint64_t)round * 1000;
+        for (int lane = 0; lane < K; lane++)
+        {
+            games[lane].setRules(rules);
+            games[lane].seed(next_seed);
+            games[lane].restart();
+            if (lane % 2)
+                prepareClear(games[lane], rng);
+            batch.setLaneState(lane, games[lane].snapshot());
+            next_seed++;
+        }
+
+        uint8_t actions[K];
+        for (int step = 0; step < STEPS; step++)
+        {
+            for (int lane = 0; lane < K; lane++)
+            {
+                actions[lane] = step == 0 && lane % 2 ? (uint8_t)BATCH_HARD_DROP : randomAction(rng);
+                applyAction(games[lane], actions[lane]);
+            }
+            batch.step(actions);
+
+            for (int lane = 0; lane < K; lane++)
+            {
+                const char *field = difference(batch.getLaneState(lane), games[lane].snapshot());
+                if (field)
+                {
+                    if (mismatches < 5)
+                        printf("  K=%d %s rodada %d passo %d lane %d: %s diferente\n",
+                               K, getBatchIsaName(isa), round, step, lane, field);
+                    mismatches++;
+                    batch.setLaneState(lane, games[lane].snapshot());
+                }
+
+                // Partida encerrada: as duas recomeçam com uma semente nova
+                if (games[lane].getGameOver())
+                {
+                    lines += games[lane].getLinesCleared();
+                    games[lane].seed(next_seed);
+                    games[lane].restart();
+                    batch.reset(lane, next_seed);
+                    next_seed++;
+                }
+            }
+        }
+        for (int lane = 0; lane < K; lane++)
+            lines += games[lane].getLinesCleared();
+    }
+
+    printf("  K=%-2d %-6s %d passos, %ld linhas recicladas, %ld divergências\n",
+           K, getBatchIsaName(isa), ROUNDS * STEPS, lines, mismatches);
+    return mismatches;
+}
+
+int main()
+{
+    long mismatches = 0;
+    printf("BoardBatch contra Game:\n");
+    for (int isa = BATCH_SCALAR; isa <= bestBatchIsa(); isa++)
+    {
+        mismatches += checkLanes<8>((BatchIsa)isa);
+        mismatches += checkLanes<16>((BatchIsa)isa);
+        mismatches += checkLanes<32>((BatchIsa)isa);
+    }
+    if (mismatches)
+    {
+        printf("FALHOU: %ld divergências\n", mismatches);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "evaluator.hpp"
+#include "game.hpp"
+#include "movegen.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+// Verificação do avaliador (make check): cada característica é recalculada
+// célula a célula, sem as máscaras nem os índices do tabuleiro, e comparada
+// com boardFeatures e com o kernel do BoardEvaluator em cada conjunto de
+// instruções da CPU. O kernel só devolve a soma ponderada, então cada
+// característica é lida com um peso 1 nela e 0 nas outras. Os tabuleiros
+// vêm de partidas jogadas ao acaso e de linhas sorteadas (uniformes,
+// misturadas, cheias, com buracos), em lotes de tamanhos variados.
+
+static const int RANDOM_BOARDS = 20000;
+static const int GAME_SEEDS = 400;
+
+static const char *FEATURE_NAMES[FEATURE_COUNT] = {
+    "height", "holes", "covered", "bumpiness", "row_transitions", "column_transitions", "wells",
+    "uniform_paper", "uniform_plastic", "uniform_metal", "uniform_glass", "uniform_organic",
+};
+
+// Referência: as definições de BoardFeature, uma célula por vez
+static void referenceFeatures(const BoardView &board, int out[FEATURE_COUNT])
+{
+    const int W = Board::Width, H = Board::Height;
+    for (int f = 0; f < FEATURE_COUNT; f++)
+        out[f] = 0;
+
+    int heights[W];
+    int top = 0;
+    for (int x = 0; x < W; x++)
+    {
+        heights[x] = 0;
+        for (int y = 0; y < H; y++)
+        {
+            if (board.isOccupied(x, y))
+                heights[x] = y + 1;
+        }
+        out[FEATURE_HEIGHT] += heights[x];
+        if (heights[x] > top)
+            top = heights[x];
+    }
+
+    for (int x = 0; x < W; x++)
+    {
+        bool hole_below = false;
+        for (int y = 0; y < heights[x]; y++)
+        {
+            if (!board.isOccupied(x, y))
+            {
+                out[FEATURE_HOLES]++;
+                hole_below = true;
+            }
+            else if (hole_below)
+                out[FEATURE_COVERED]++;
+        }
+    }
+
+    for (int x = 1; x < W; x++)
+        out[FEATURE_BUMPINESS] += abs(heights[x] - heights[x - 1]);
+
+    // Paredes cheias dos dois lados, só nas linhas até o topo
+    for (int y = 0; y < top; y++)
+    {
+        bool previous = true;
+        for (int x = 0; x < W; x++)
+        {
+            bool occupied = board.isOccupied(x, y);
+            if (occupied != previous)
+                out[FEATURE_ROW_TRANSITIONS]++;
+            previous = occupied;
+        }
+        if (!previous)
+            out[FEATURE_ROW_TRANSITIONS]++;
+    }
+
+    // Chão cheio, topo aberto
+    for (int x = 0; x < W; x++)
+    {
+        bool previous = true;
+        for (int y = 0; y < H; y++)
+        {
+            bool occupied = board.isOccupied(x, y);
+            if (occupied != previous)
+                out[FEATURE_COLUMN_TRANSITIONS]++;
+            previous = occupied;
+        }
+    }
+
+    for (int x = 0; x < W; x++)
+    {
+        int left = x > 0 ? heights[x - 1] : H;
+        int right = x < W - 1 ? heights[x + 1] : H;
+        int depth = (left < right ? left : right) - heights[x];
+        if (depth > 0)
+            out[FEATURE_WELLS] += depth;
+    }
+
+    for (int y = 0; y < H; y++)
+    {
+        int fill = 0;
+        TrashType type = NONE;
+        bool uniform = true;
+        for (int x = 0; x < W; x++)
+        {
+            if (!board.isOccupied(x, y))
+                continue;
+            TrashType cell = board.getType(x, y);
+            if (fill > 0 && cell != type)
+                uniform = false;
+            type = cell;
+            fill++;
+        }
+        if (fill > 0 && uniform)
+            out[FEATURE_UNIFORM_PAPER + type] += fill * fill;
+    }
+}
+
+// Linhas sorteadas de baixo até uma altura qualquer
+static void randomBoard(Board &board, Rng &rng)
+{
+    board.clear();
+    int top = rng.below(Board::Height + 1);
+    for (int y = 0; y < top; y++)
+    {
+        int mode = rng.below(4); // 0 cheia, 1 de um tipo, 2 e 3 misturadas
+        TrashType type = (TrashType)rng.below(5);
+        for (int x = 0; x < Board::Width; x++)
+        {
+            bool occupied = mode == 0 || rng.below(3) != 0;
+            if (occupied)
+                board.setCell(x, y, true, mode == 1 ? type : (TrashType)rng.below(5));
+        }
+    }
+}
+
+static void gameBoards(std::vector<Board> &boards)
+{
+    MoveGenerator generator;
+    std::vector<Move> moves;
+    for (uint64_t seed = 1; seed <= GAME_SEEDS; seed++)
+    {
+        Game game;
+        game.seed(seed);
+        game.restart();
+        Rng rng(seed, 5);
+        while (!game.getGameOver() && generator.generate(game, moves) > 0)
+        {
+            MoveGenerator::apply(game, moves[rng.below(moves.size())]);
+            boards.push_back(game.snapshot().board);
+        }
+    }
+}
+
+int main()
+{
+    std::vector<Board> boards(RANDOM_BOARDS);
+    Rng rng(0xe7a1, 3);
+    for (Board &board : boards)
+        randomBoard(board, rng);
+    gameBoards(boards);
+
+    int count = (int)boards.size();
+    std::vector<BoardView> views;
+    std::vector<int> expected((size_t)count * FEATURE_COUNT);
+    long failures = 0;
+    for (int i = 0; i < count; i++)
+    {
+        views.push_back(BoardView(boards[i]));
+        referenceFeatures(views[i], &expected[(size_t)i * FEATURE_COUNT]);
+
+        int features[FEATURE_COUNT];
+        boardFeatures(views[i], features);
+        for (int f = 0; f < FEATURE_COUNT; f++)
+        {
+            if (features[f] != expected[(size_t)i * FEATURE_COUNT + f])
+            {
+                if (failures < 5)
+                    printf("  boardFeatures tabuleiro %d: %s = %d, esperado %d\n", i, FEATURE_NAMES[f],
+                           features[f], expected[(size_t)i * FEATURE_COUNT + f]);
+                failures++;
+            }
+        }
+    }
+    printf("Avaliador contra referência célula a célula (%d tabuleiros):\n", count);
+    printf("  boardFeatures: %ld divergências\n", failures);
+
+    std::vector<double> values(count);
+    for (int isa = BATCH_SCALAR; isa <= bestBatchIsa(); isa++)
+    {
+        BoardEvaluator evaluator((BatchIsa)isa);
+        long isa_failures = 0;
+        for (int f = 0; f < FEATURE_COUNT; f++)
+        {
+            EvalWeights weights;
+            weights.feature[f] = 1;
+            evaluator.setWeights(weights);
+
+            // Lotes de 1 a 40 tabuleiros: lanes parciais e vários runs
+            for (int first = 0, step = 0; first < count; step++)
+            {
+                int batch = 1 + (first * 7 + step) % 40;
+                if (first + batch > count)
+                    batch = count - first;
+                evaluator.evaluate(&views[first], batch, &values[first]);
+                first += batch;
+            }
+            for (int i = 0; i < count; i++)
+            {
+                int want = expected[(size_t)i * FEATURE_COUNT + f];
+                if (values[i] != want)
+                {
+                    if (isa_failures < 5)
+                        printf("  %s tabuleiro %d: %s = %g, esperado %d\n", getBatchIsaName(evaluator.getIsa()),
+                               i, FEATURE_NAMES[f], values[i], want);
+                    isa_failures++;
+                }
+            }
+        }
+        printf("  %-6s: %ld divergências\n", getBatchIsaName(evaluator.getIsa()), isa_failures);
+        failures += isa_failures;
+    }
+
+    if (failures)
+    {
+        printf("FALHOU: %ld divergências\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
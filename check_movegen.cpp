@@ -0,0 +1,281 @@
+#include "game.hpp"
+#include "movegen.hpp"
+#include "pieces.hpp"
+#include <stdio.h>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+
+// Verificação do gerador de jogadas (make check). Em posições de partidas
+// jogadas ao acaso (com buracos e saliências), as jogadas geradas têm de ser
+// exatamente as posições finais que uma busca em largura alcança com as
+// próprias entradas do Game (mover, girar, descer), com e sem hold, e
+// MoveGenerator::apply tem de deixar o jogo igual ao caminho de entradas
+// que leva à mesma posição. No fim, as contagens de perft da semente 1 são
+// comparadas com os valores fixados abaixo.
+
+static const int SEEDS = 200;
+static const int PIECES = 300;
+
+enum Input {INPUT_LEFT, INPUT_RIGHT, INPUT_ROTATE, INPUT_DOWN};
+
+typedef std::vector<std::pair<int, int>> Cells;
+typedef std::map<Cells, std::vector<int>> Landings; // Células da peça travada -> entradas até lá
+
+struct PerftCount {
+    int depth;
+    bool hold;
+    uint64_t leaves;
+};
+
+// Folhas esperadas a partir do início da partida de semente 1
+static const PerftCount PERFT_COUNTS[] = {
+    {1, false, 34},
+    {2, false, 1175},
+    {3, false, 41853},
+    {1, true, 68},
+    {2, true, 4711},
+};
+
+static Cells pieceCells(int shape, int rotation, int x, int y)
+{
+    Cells cells;
+    const PieceMask &mask = pieceMask(shape, rotation);
+    for (int i = 0; i < mask.height; i++)
+    {
+        for (int b = 0; b < 16; b++)
+        {
+            if ((mask.rows[i] >> b) & 1)
+                cells.push_back(std::make_pair(x + mask.min_dx + b, y + mask.min_dy + i));
+        }
+    }
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+static void press(Game &game, int input)
+{
+    switch (input)
+    {
+    case INPUT_LEFT: game.translate(-1); break;
+    case INPUT_RIGHT: game.translate(1); break;
+    case INPUT_ROTATE: game.rotate(); break;
+    case INPUT_DOWN: game.moveDown(); break;
+    }
+}
+
+// Busca em largura sobre (x, y, rotação) da peça atual usando só o Game:
+// toda descida que trava a peça é uma posição final. Um hold que encerra
+// a partida (peça trocada nasce em colisão) não tem nenhuma.
+static void searchLandings(const Game &game, Landings &landings)
+{
+    if (!game.hasActivePiece() || game.getGameOver())
+        return;
+
+    struct Node {
+        int x, y, rotation;
+        std::vector<int> path;
+    };
+
+    GameState start = game.snapshot();
+    int shape = game.getCurrentShape();
+    TrashType types[4];
+    for (int i = 0; i < 4; i++)
+        types[i] = game.getCurrentTrashTypes()[i];
+
+    std::deque<Node> queue;
+    std::set<std::tuple<int, int, int>> seen;
+    Node root = {game.getCurrentX(), game.getCurrentY(), game.getCurrentRotation(), {}};
+    queue.push_back(root);
+    seen.insert(std::make_tuple(root.x, root.y, root.rotation));
+
+    Game trial;
+    while (!queue.empty())
+    {
+        Node node = queue.front();
+        queue.pop_front();
+        for (int input = INPUT_LEFT; input <= INPUT_DOWN; input++)
+        {
+            trial.restore(start);
+            trial.setCurrentPiece(shape, node.rotation, node.x, node.y, types);
+            int placed = trial.getPiecesPlaced();
+            press(trial, input);
+
+            std::vector<int> path = node.path;
+            path.push_back(input);
+            if (trial.getPiecesPlaced() != placed)
+            {
+                Cells cells = pieceCells(shape, node.rotation, node.x, node.y);
+                if (!landings.count(cells))
+                    landings[cells] = path;
+                continue;
+            }
+            Node next = {trial.getCurrentX(), trial.getCurrentY(), trial.getCurrentRotation(), path};
+            if (seen.insert(std::make_tuple(next.x, next.y, next.rotation)).second)
+                queue.push_back(next);
+        }
+    }
+}
+
+static bool sameGame(const Game &a, const Game &b)
+{
+    BoardView va = a.getBoardView(), vb = b.getBoardView();
+    for (int y = 0; y < Board::Height; y++)
+    {
+        if (va.getRow(y) != vb.getRow(y))
+            return false;
+    }
+    return a.getBoardHash() == b.getBoardHash() && a.getHash() == b.getHash()
+        && a.getScore() == b.getScore() && a.getPiecesPlaced() == b.getPiecesPlaced()
+        && a.getLinesCleared() == b.getLinesCleared() && a.getGameOver() == b.getGameOver();
+}
+
+// Compara as jogadas de um lado (com ou sem hold) com a busca de
+// referência no jogo dado; replay confere também apply. Devolve as falhas.
+static int checkSide(const Game &game, const Game &reference, const std::vector<Move> &moves, bool hold,
+                     bool replay, const char *where)
+{
+    Landings landings;
+    searchLandings(reference, landings);
+
+    std::set<Cells> generated;
+    int count = 0;
+    for (const Move &move : moves)
+    {
+        if (move.hold != hold)
+            continue;
+        generated.insert(pieceCells(reference.getCurrentShape(), move.rotation, move.x, move.y));
+        count++;
+    }
+
+    int failures = 0;
+    std::set<Cells> expected;
+    for (const auto &landing : landings)
+        expected.insert(landing.first);
+    if (generated != expected || (int)generated.size() != count)
+    {
+        printf("  %s%s: %d jogadas geradas (%zu distintas), %zu na busca\n", where, hold ? " com hold" : "",
+               count, generated.size(), expected.size());
+        failures++;
+    }
+    if (!replay)
+        return failures;
+
+    GameState start = game.snapshot();
+    Game applied, played;
+    for (const Move &move : moves)
+    {
+        if (move.hold != hold)
+            continue;
+        auto landing = landings.find(pieceCells(reference.getCurrentShape(), move.rotation, move.x, move.y));
+        if (landing == landings.end())
+            continue;
+        applied.restore(start);
+        MoveGenerator::apply(applied, move);
+        played.restore(start);
+        if (hold)
+            played.holdPiece();
+        for (int input : landing->second)
+            press(played, input);
+        if (!sameGame(applied, played))
+        {
+            printf("  %s%s: apply diverge das entradas\n", where, hold ? " com hold" : "");
+            failures++;
+            break;
+        }
+    }
+    return failures;
+}
+
+static int checkPositions()
+{
+    MoveGenerator generator;
+    std::vector<Move> moves;
+    int failures = 0;
+    long positions = 0, total = 0;
+
+    for (uint64_t seed = 1; seed <= SEEDS; seed++)
+    {
+        Game game;
+        game.seed(seed);
+        game.restart();
+        Rng rng(seed, 9);
+        for (int piece = 0; piece < PIECES && !game.getGameOver(); piece++)
+        {
+            char where[64];
+            snprintf(where, sizeof(where), "semente %llu peça %d", (unsigned long long)seed, piece);
+            bool replay = piece % 10 == 0;
+
+            generator.generate(game, moves, true);
+            failures += checkSide(game, game, moves, false, replay, where);
+            if (game.canHold())
+            {
+                Game held;
+                held.restore(game.snapshot());
+                held.holdPiece();
+                failures += checkSide(game, held, moves, true, replay, where);
+            }
+            else
+            {
+                for (const Move &move : moves)
+                {
+                    if (move.hold)
+                    {
+                        printf("  %s: jogada com hold sem hold disponível\n", where);
+                        failures++;
+                        break;
+                    }
+                }
+            }
+            positions++;
+            total += moves.size();
+            if (failures > 5)
+                return failures;
+
+            // Uma jogada qualquer, às vezes pelo hold: buracos e saliências
+            // aparecem sozinhos
+            MoveGenerator::apply(game, moves[rng.below(moves.size())]);
+        }
+    }
+    printf("  %ld posições, %.1f jogadas por posição (com hold), %d falhas\n", positions,
+           (double)total / positions, failures);
+    return failures;
+}
+
+static int checkPerft()
+{
+    Game game;
+    game.seed(1);
+    game.restart();
+    MoveGenerator generator;
+
+    int failures = 0;
+    for (const PerftCount &count : PERFT_COUNTS)
+    {
+        uint64_t leaves = generator.perft(game, count.depth, count.hold);
+        bool ok = leaves == count.leaves;
+        printf("  perft %d%s: %llu (esperado %llu)%s\n", count.depth, count.hold ? " com hold" : "",
+               (unsigned long long)leaves, (unsigned long long)count.leaves, ok ? "" : " ERRO");
+        if (!ok)
+            failures++;
+    }
+    return failures;
+}
+
+int main()
+{
+    printf("MoveGenerator contra busca em largura:\n");
+    int failures = checkPositions();
+    printf("Contagens de perft (semente 1):\n");
+    failures += checkPerft();
+    if (failures)
+    {
+        printf("FALHOU: %d falhas\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+#ifndef ECOTETRIS_ENV_H
+#define ECOTETRIS_ENV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Ambiente de aprendizado por reforço com ABI C (libecotetris_env.so).
+ *
+ * Um EcoEnv agrupa N partidas 10x20 que avançam juntas: eco_env_reset e
+ * eco_env_step recebem uma ação por partida, avançam todas em paralelo num
+ * pool de threads e escrevem a observação de cada uma direto num anel de
+ * memória fornecido pelo chamador (por exemplo um segmento de /dev/shm ou um
+ * buffer do numpy). O treinador lê as observações no próprio anel, sem cópia.
+ *
+ * Layout do anel: um EcoRingHeader no início e, a partir do byte
+ * ECO_RING_DATA_OFFSET, `capacity` slots seguidos; cada slot guarda as N
+ * observações (EcoObservation) de um reset ou passo. A biblioteca
+ * publica o slot incrementando write_index; o treinador libera slots
+ * incrementando read_index. Os dois índices são lidos e escritos de forma
+ * atômica (acquire/release), então o anel pode ser compartilhado entre
+ * processos.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECO_BOARD_WIDTH 10
+#define ECO_BOARD_HEIGHT 20
+#define ECO_TRASH_TYPES 5
+#define ECO_RING_MAGIC 0x45434f52u /* "ECOR" */
+#define ECO_RING_DATA_OFFSET 64   /* slots começam alinhados a uma linha de cache */
+
+/* Códigos de retorno (negativos) */
+#define ECO_ERR_ARGS -1 /* argumentos inválidos */
+#define ECO_ERR_FULL -2 /* anel cheio: o treinador ainda não liberou slots */
+
+/* Tipo de ação */
+enum EcoActionKind {
+    ECO_ACTION_PLACEMENT = 0, /* jogada final: rotação, coluna e hold, seguida de hard drop */
+    ECO_ACTION_RAW = 1        /* uma entrada, como no teclado */
+};
+
+/* Entradas da ação ECO_ACTION_RAW, com a mesma semântica dos métodos de Game */
+enum EcoRawInput {
+    ECO_RAW_NONE = 0,
+    ECO_RAW_LEFT = 1,      /* translate(-1) */
+    ECO_RAW_RIGHT = 2,     /* translate(1) */
+    ECO_RAW_ROTATE = 3,    /* rotate() */
+    ECO_RAW_DOWN = 4,      /* moveDown() */
+    ECO_RAW_HARD_DROP = 5, /* hardDrop() */
+    ECO_RAW_HOLD = 6       /* holdPiece() */
+};
+
+typedef struct EcoAction {
+    uint8_t kind;     /* EcoActionKind */
+    uint8_t raw;      /* EcoRawInput, se kind == ECO_ACTION_RAW */
+    uint8_t rotation; /* rotação da jogada, se kind == ECO_ACTION_PLACEMENT */
+    int8_t column;    /* coluna da âncora da jogada */
+    uint8_t hold;     /* 1 = usar o hold antes da jogada */
+    uint8_t padding[3];
+} EcoAction;
+
+/*
+ * Observação de uma partida. Cada plano tem uma palavra por linha (linha 0
+ * embaixo) com o bit x = coluna x. Os planos por tipo marcam as células
+ * travadas de cada TrashType (papel, plástico, metal, vidro, orgânico).
+ */
+typedef struct EcoObservation {
+    uint16_t occupied[ECO_BOARD_HEIGHT];
+    uint16_t type_planes[ECO_TRASH_TYPES][ECO_BOARD_HEIGHT];
+    uint16_t active_piece[ECO_BOARD_HEIGHT];
+    int32_t score;
+    int32_t score_delta; /* pontos ganhos neste passo */
+    int32_t lines_cleared;
+    int32_t level;
+    int32_t pieces_placed;
+    int8_t curr_shape; /* -1 sem peça ativa */
+    int8_t curr_rotation;
+    int8_t curr_x;
+    int8_t curr_y;
+    int8_t curr_type;
+    int8_t next_shape;
+    int8_t next_type;
+    int8_t hold_shape; /* -1 se o hold está vazio */
+    int8_t hold_type;
+    uint8_t can_hold;
+    uint8_t done;  /* game over neste passo; a partida recomeça no próximo */
+    uint8_t reset; /* 1 se a partida começou neste passo (ação ignorada) */
+} EcoObservation;
+
+typedef struct EcoRingHeader {
+    uint32_t magic;
+    uint32_t num_envs;
+    uint32_t capacity;    /* número de slots */
+    uint32_t slot_bytes;  /* num_envs * sizeof(EcoObservation) */
+    uint64_t write_index; /* slots publicados (escrito pela biblioteca) */
+    uint64_t read_index;  /* slots consumidos (escrito pelo treinador) */
+} EcoRingHeader;
+
+typedef struct EcoEnv EcoEnv;
+
+/* Bytes necessários para um anel com num_envs partidas e capacity slots */
+size_t eco_ring_bytes(uint32_t num_envs, uint32_t capacity);
+
+/* Observações do slot com esse índice (write_index - 1 = o mais recente) */
+EcoObservation *eco_ring_slot(void *ring, uint64_t index);
+
+/*
+ * Cria num_envs partidas escrevendo no anel `ring` (ring_bytes bytes, pelo
+ * menos eco_ring_bytes(num_envs, capacity)); o cabeçalho do anel é
+ * inicializado aqui. num_workers = 0 usa todos os núcleos. Devolve NULL se
+ * os argumentos forem inválidos. O anel continua sendo do chamador.
+ */
+EcoEnv *eco_env_create(uint32_t num_envs, uint32_t num_workers, void *ring, size_t ring_bytes,
+                       uint32_t capacity);
+void eco_env_destroy(EcoEnv *env);
+
+uint32_t eco_env_num_envs(const EcoEnv *env);
+uint32_t eco_env_num_workers(const EcoEnv *env);
+
+/*
+ * Recomeça todas as partidas (a partida i usa a semente seed + i; depois de
+ * cada game over a semente avança num_envs) e publica as observações
+ * iniciais. Devolve o índice do slot escrito ou um código de erro.
+ */
+int64_t eco_env_reset(EcoEnv *env, uint64_t seed);
+
+/*
+ * Aplica actions[i] à partida i e publica as observações. Uma partida que
+ * terminou no passo anterior recomeça e ignora a ação. As linhas completas
+ * saem do tabuleiro na própria trava, então a observação sempre traz a
+ * próxima peça pronta para decidir. Não há gravidade: no modo RAW a peça só
+ * desce com DOWN ou HARD_DROP.
+ * Devolve o índice do slot escrito ou um código de erro.
+ */
+int64_t eco_env_step(EcoEnv *env, const EcoAction *actions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECOTETRIS_ENV_H */
@@ -0,0 +1,219 @@
+#include "ecotetris_env.h"
+#include "game.hpp"
+#include "policy.hpp"
+#include "thread_pool.hpp"
+#include <memory>
+#include <new>
+#include <vector>
+
+static_assert(ECO_BOARD_WIDTH == Board::Width && ECO_BOARD_HEIGHT == Board::Height,
+              "a observação segue as dimensões de Board");
+static_assert(ECO_TRASH_TYPES == NONE, "um plano por tipo de lixo");
+static_assert(sizeof(EcoObservation) == 312, "layout da observação faz parte da ABI");
+static_assert(sizeof(EcoRingHeader) <= ECO_RING_DATA_OFFSET, "cabeçalho do anel cabe antes dos slots");
+
+// Partidas de um EcoEnv. Cada uma é avançada por uma única tarefa por passo,
+// então as threads do pool nunca tocam na mesma partida.
+struct EcoEnv {
+    EcoEnv(uint32_t num_envs, uint32_t num_workers, EcoRingHeader *ring)
+        : num_envs(num_envs), ring(ring), pool((int)num_workers),
+          games(new Game[num_envs]), next_seed(num_envs), restart_pending(num_envs) {}
+
+    uint32_t num_envs;
+    EcoRingHeader *ring;
+    ThreadPool pool;
+    std::unique_ptr<Game[]> games;
+    std::vector<uint64_t> next_seed;
+    std::vector<uint8_t> restart_pending;
+};
+
+static EcoObservation *slotAt(EcoRingHeader *ring, uint64_t index){
+    char *data = reinterpret_cast<char *>(ring) + ECO_RING_DATA_OFFSET;
+    return reinterpret_cast<EcoObservation *>(data + (index % ring->capacity) * ring->slot_bytes);
+}
+
+static void observe(const Game &game, EcoObservation &obs){
+    BoardView view = game.getBoardView();
+    const uint16_t *rows = view.getRows();
+    const uint16_t *p0 = view.getTypePlane(0);
+    const uint16_t *p1 = view.getTypePlane(1);
+    const uint16_t *p2 = view.getTypePlane(2);
+
+    // Tipo t = bits dos três planos: a célula é do tipo t onde cada plano
+    // bate com o bit correspondente de t
+    for (int y = 0; y < Board::Height; y++) {
+        obs.occupied[y] = rows[y];
+        for (int t = 0; t < ECO_TRASH_TYPES; t++) {
+            uint16_t match = rows[y];
+            match &= (t & 1) ? p0[y] : (uint16_t)~p0[y];
+            match &= (t & 2) ? p1[y] : (uint16_t)~p1[y];
+            match &= (t & 4) ? p2[y] : (uint16_t)~p2[y];
+            obs.type_planes[t][y] = match;
+        }
+        obs.active_piece[y] = 0;
+    }
+
+    if (game.hasActivePiece()) {
+        const PieceMask &piece = pieceMask(game.getCurrentShape(), game.getCurrentRotation());
+        int left = game.getCurrentX() + piece.min_dx;
+        int bottom = game.getCurrentY() + piece.min_dy;
+        for (int r = 0; r < piece.height; r++) {
+            if (bottom + r >= 0 && bottom + r < Board::Height) {
+                obs.active_piece[bottom + r] = (uint16_t)(piece.rows[r] << left);
+            }
+        }
+        obs.curr_shape = (int8_t)game.getCurrentShape();
+        obs.curr_rotation = (int8_t)game.getCurrentRotation();
+        obs.curr_x = (int8_t)game.getCurrentX();
+        obs.curr_y = (int8_t)game.getCurrentY();
+        obs.curr_type = (int8_t)game.getCurrentTrashTypes()[0];
+    }
+    else {
+        obs.curr_shape = -1;
+        obs.curr_rotation = 0;
+        obs.curr_x = 0;
+        obs.curr_y = 0;
+        obs.curr_type = NONE;
+    }
+
+    obs.score = game.getScore();
+    obs.lines_cleared = game.getLinesCleared();
+    obs.level = game.getLevel();
+    obs.pieces_placed = game.getPiecesPlaced();
+    obs.next_shape = (int8_t)game.getNextShape();
+    obs.next_type = (int8_t)game.getNextTrashTypes()[0];
+    obs.hold_shape = (int8_t)game.getHoldShape();
+    obs.hold_type = (int8_t)(game.getHoldShape() == -1 ? NONE : game.getHoldTrashTypes()[0]);
+    obs.can_hold = game.canHold();
+    obs.done = game.getGameOver();
+}
+
+static void restartEnv(EcoEnv &env, uint32_t i, EcoObservation &obs){
+    Game &game = env.games[i];
+    game.seed(env.next_seed[i]);
+    game.restart();
+    env.next_seed[i] += env.num_envs;
+    env.restart_pending[i] = 0;
+
+    observe(game, obs);
+    obs.score_delta = 0;
+    obs.reset = 1;
+}
+
+static void stepEnv(EcoEnv &env, uint32_t i, const EcoAction &action, EcoObservation &obs){
+    if (env.restart_pending[i]) {
+        restartEnv(env, i, obs);
+        return;
+    }
+
+    Game &game = env.games[i];
+    int score_before = game.getScore();
+    if (action.kind == ECO_ACTION_PLACEMENT) {
+        Placement placement;
+        placement.rotation = action.rotation % 4;
+        placement.x = action.column;
+        placement.hold = action.hold != 0;
+        applyPlacement(game, placement);
+    }
+    else {
+        switch (action.raw) {
+            case ECO_RAW_LEFT: game.translate(-1); break;
+            case ECO_RAW_RIGHT: game.translate(1); break;
+            case ECO_RAW_ROTATE: game.rotate(); break;
+            case ECO_RAW_DOWN: game.moveDown(); break;
+            case ECO_RAW_HARD_DROP: game.hardDrop(); break;
+            case ECO_RAW_HOLD: game.holdPiece(); break;
+            default: break;
+        }
+    }
+
+    observe(game, obs);
+    obs.score_delta = game.getScore() - score_before;
+    obs.reset = 0;
+    if (game.getGameOver()) env.restart_pending[i] = 1;
+}
+
+// Reserva o próximo slot, avança todas as partidas em paralelo escrevendo
+// direto nele e o publica. reset_all recomeça todas, senão aplica actions.
+static int64_t publish(EcoEnv *env, const EcoAction *actions, bool reset_all){
+    EcoRingHeader *ring = env->ring;
+    uint64_t write = ring->write_index;
+    uint64_t read = __atomic_load_n(&ring->read_index, __ATOMIC_ACQUIRE);
+    if (write - read >= ring->capacity) return ECO_ERR_FULL;
+
+    EcoObservation *slot = slotAt(ring, write);
+    uint32_t tasks = (uint32_t)env->pool.getThreadCount() * 4;
+    if (tasks > env->num_envs) tasks = env->num_envs;
+    uint32_t chunk = (env->num_envs + tasks - 1) / tasks;
+
+    for (uint32_t first = 0; first < env->num_envs; first += chunk) {
+        uint32_t last = first + chunk < env->num_envs ? first + chunk : env->num_envs;
+        env->pool.submit([env, actions, reset_all, slot, first, last](int) {
+            for (uint32_t i = first; i < last; i++) {
+                if (reset_all) restartEnv(*env, i, slot[i]);
+                else stepEnv(*env, i, actions[i], slot[i]);
+            }
+        });
+    }
+    env->pool.wait();
+
+    __atomic_store_n(&ring->write_index, write + 1, __ATOMIC_RELEASE);
+    return (int64_t)write;
+}
+
+extern "C" {
+
+size_t eco_ring_bytes(uint32_t num_envs, uint32_t capacity){
+    return ECO_RING_DATA_OFFSET + (size_t)capacity * num_envs * sizeof(EcoObservation);
+}
+
+EcoObservation *eco_ring_slot(void *ring, uint64_t index){
+    return slotAt(static_cast<EcoRingHeader *>(ring), index);
+}
+
+EcoEnv *eco_env_create(uint32_t num_envs, uint32_t num_workers, void *ring, size_t ring_bytes,
+                       uint32_t capacity){
+    if (num_envs == 0 || capacity == 0 || !ring || ring_bytes < eco_ring_bytes(num_envs, capacity)) {
+        return NULL;
+    }
+
+    EcoRingHeader *header = static_cast<EcoRingHeader *>(ring);
+    header->magic = ECO_RING_MAGIC;
+    header->num_envs = num_envs;
+    header->capacity = capacity;
+    header->slot_bytes = num_envs * (uint32_t)sizeof(EcoObservation);
+    header->write_index = 0;
+    header->read_index = 0;
+
+    return new (std::nothrow) EcoEnv(num_envs, num_workers, header);
+}
+
+void eco_env_destroy(EcoEnv *env){
+    delete env;
+}
+
+uint32_t eco_env_num_envs(const EcoEnv *env){
+    return env->num_envs;
+}
+
+uint32_t eco_env_num_workers(const EcoEnv *env){
+    return (uint32_t)env->pool.getThreadCount();
+}
+
+int64_t eco_env_reset(EcoEnv *env, uint64_t seed){
+    if (!env) return ECO_ERR_ARGS;
+    for (uint32_t i = 0; i < env->num_envs; i++) {
+        env->next_seed[i] = seed + i;
+    }
+    return publish(env, NULL, true);
+}
+
+int64_t eco_env_step(EcoEnv *env, const EcoAction *actions){
+    if (!env || !actions) return ECO_ERR_ARGS;
+    for (uint32_t i = 0; i < env->num_envs; i++) {
+        if (actions[i].kind > ECO_ACTION_RAW || actions[i].raw > ECO_RAW_HOLD) return ECO_ERR_ARGS;
+    }
+    return publish(env, actions, false);
+}
+
+}
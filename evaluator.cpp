@@ -0,0 +1,231 @@
+#include "evaluator.hpp"
+#include <string.h>
+
+// Vetores de N lanes de 16 bits, como em batch.cpp: o mesmo kernel vira
+// SSE2 com N = 8 e AVX2 com N = 16. Com N = 1 a lane é um uint16_t comum,
+// com o popcount da CPU.
+#define EVAL_INLINE static inline __attribute__((always_inline))
+
+template<int N>
+struct EvalVec {
+    typedef uint16_t U __attribute__((vector_size(2 * N)));
+
+    // Sempre expandidos dentro do kernel (ver a nota de ABI em batch.cpp)
+    EVAL_INLINE U load(const uint16_t *p){
+        U v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    EVAL_INLINE void store(uint16_t *p, U v) { memcpy(p, &v, sizeof(v)); }
+
+    // 0xFFFF nas lanes diferentes de zero
+    EVAL_INLINE U nonzero(U v) { return (U)(v != 0); }
+    EVAL_INLINE U isZero(U v) { return (U)(v == 0); }
+
+    // SSE2 e AVX2 não têm popcount para lanes de 16 bits: soma em árvore
+    EVAL_INLINE U popcount(U x){
+        x = x - ((x >> 1) & 0x5555);
+        x = (x & 0x3333) + ((x >> 2) & 0x3333);
+        x = (x + (x >> 4)) & 0x0f0f;
+        return (x + (x >> 8)) & 0x1f;
+    }
+};
+
+template<>
+struct EvalVec<1> {
+    typedef uint16_t U;
+
+    EVAL_INLINE U load(const uint16_t *p) { return *p; }
+    EVAL_INLINE void store(uint16_t *p, U v) { *p = v; }
+    EVAL_INLINE U nonzero(U v) { return v ? 0xFFFF : 0; }
+    EVAL_INLINE U isZero(U v) { return v ? 0 : 0xFFFF; }
+    EVAL_INLINE U popcount(U x) { return (U)bitCount(x); }
+};
+
+// Características das lanes [o, o + N). Uma passada de cima para baixo
+// acumula a máscara das colunas que têm bloco acima de cada linha: alturas,
+// buracos, irregularidade e poços viram popcounts dessa máscara. Uma
+// passada de baixo para cima conta os blocos sobre buracos. Acima de top
+// (a linha vazia mais baixa acima de todas as pilhas) nada muda, exceto a
+// transição da própria linha top nas colunas.
+template<int K, int N>
+EVAL_INLINE void evaluateChunk(EvalLanes<K> &d, int o, int top){
+    typedef EvalVec<N> V;
+    typedef typename V::U U;
+    const int W = Board::Width;
+    const int H = Board::Height;
+    const U zero = {};
+    const U full = zero + (uint16_t)lowBits(W);
+    const U pairs = zero + (uint16_t)lowBits(W - 1);  // Colunas x e x + 1
+    const U walls = zero + (uint16_t)(1 | 1 << (W + 1)); // Paredes nos bits 0 e W + 1
+    const U edges = zero + (uint16_t)lowBits(W + 1);  // Parede, W colunas, parede
+
+    U height = zero, holes = zero, covered = zero, bumpiness = zero;
+    U row_transitions = zero, column_transitions = zero, wells = zero;
+    U uniform[NONE] = {};
+    U hole_rows[H];
+
+    int start = top < H ? top : H - 1;
+    U above = zero; // Colunas com algum bloco acima da linha
+    for (int y = start; y >= 0; y--) {
+        U row = V::load(&d.rows[y][o]);
+        U reached = above | row; // Colunas com altura maior que y
+
+        height += V::popcount(reached);
+        hole_rows[y] = above & ~row;
+        holes += V::popcount(hole_rows[y]);
+        bumpiness += V::popcount((reached ^ (reached >> 1)) & pairs);
+
+        // Célula livre com as duas vizinhas (ou paredes) já alcançadas
+        U sides = (reached << 1) | walls;
+        wells += V::popcount(~reached & full & sides & (sides >> 2));
+
+        // Só as linhas até o topo contam: acima dele toda linha teria 2
+        U bordered = (row << 1) | walls;
+        row_transitions += V::popcount((bordered ^ (bordered >> 1)) & edges) & V::nonzero(reached);
+
+        U below = y > 0 ? V::load(&d.rows[y - 1][o]) : full;
+        column_transitions += V::popcount(row ^ below);
+
+        // Linha de um só tipo: nenhum bloco fora da máscara daquele tipo
+        U fill = V::popcount(row);
+        U filled = V::nonzero(row);
+        U p0 = V::load(&d.planes[0][y][o]);
+        U p1 = V::load(&d.planes[1][y][o]);
+        U p2 = V::load(&d.planes[2][y][o]);
+        for (int t = 0; t < NONE; t++) {
+            U match = ((t & 1) ? p0 : ~p0) & ((t & 2) ? p1 : ~p1) & ((t & 4) ? p2 : ~p2);
+            U single = filled & V::isZero(row & ~match);
+            uniform[t] += single & (fill * fill);
+        }
+
+        above = reached;
+    }
+
+    U hole_below = zero;
+    for (int y = 0; y <= start; y++) {
+        covered += V::popcount(V::load(&d.rows[y][o]) & hole_below);
+        hole_below |= hole_rows[y];
+    }
+
+    V::store(&d.features[FEATURE_HEIGHT][o], height);
+    V::store(&d.features[FEATURE_HOLES][o], holes);
+    V::store(&d.features[FEATURE_COVERED][o], covered);
+    V::store(&d.features[FEATURE_BUMPINESS][o], bumpiness);
+    V::store(&d.features[FEATURE_ROW_TRANSITIONS][o], row_transitions);
+    V::store(&d.features[FEATURE_COLUMN_TRANSITIONS][o], column_transitions);
+    V::store(&d.features[FEATURE_WELLS][o], wells);
+    for (int t = 0; t < NONE; t++) {
+        V::store(&d.features[FEATURE_UNIFORM_PAPER + t][o], uniform[t]);
+    }
+}
+
+// Versões do kernel para cada conjunto de instruções
+template<int K, int N>
+EVAL_INLINE void evaluateLanes(EvalLanes<K> &d, int top){
+    for (int o = 0; o < K; o += N) {
+        evaluateChunk<K, N>(d, o, top);
+    }
+}
+
+static void kernelScalar(EvalLanes<BoardEvaluator::Lanes> &d, int top) { evaluateLanes<BoardEvaluator::Lanes, 1>(d, top); }
+static void kernelSse2(EvalLanes<BoardEvaluator::Lanes> &d, int top) { evaluateLanes<BoardEvaluator::Lanes, 8>(d, top); }
+
+#if defined(__x86_64__) || defined(__i386__)
+#define EVAL_HAS_AVX2 1
+__attribute__((target("avx2"))) static void kernelAvx2(EvalLanes<BoardEvaluator::Lanes> &d, int top) {
+    evaluateLanes<BoardEvaluator::Lanes, 16>(d, top);
+}
+#endif
+
+// Copia as linhas ocupadas e os planos de tipo de um tabuleiro para uma
+// lane, sobrescrevendo também as antigas até a linha top (acima dela a
+// lane já está vazia); devolve a linha acima do bloco mais alto
+template<int K>
+static int loadLane(EvalLanes<K> &d, int lane, const BoardView &board, int top){
+    const uint16_t *rows = board.getRows();
+    int height = Board::Height;
+    while (height > 0 && rows[height - 1] == 0) height--;
+
+    int copied = height > top ? height : top;
+    if (copied == Board::Height) copied--; // A linha top também é lida
+    for (int y = 0; y <= copied; y++) {
+        d.rows[y][lane] = rows[y];
+    }
+    for (int p = 0; p < Board::TypePlanes; p++) {
+        const uint16_t *plane = board.getTypePlane(p);
+        for (int y = 0; y <= copied; y++) {
+            d.planes[p][y][lane] = plane[y];
+        }
+    }
+    return height;
+}
+
+void boardFeatures(const BoardView &board, int out[FEATURE_COUNT]){
+    EvalLanes<1> d;
+    int top = loadLane(d, 0, board, 0);
+    evaluateLanes<1, 1>(d, top);
+    for (int f = 0; f < FEATURE_COUNT; f++) {
+        out[f] = d.features[f][0];
+    }
+}
+
+double weighFeatures(const EvalWeights &weights, const int features[FEATURE_COUNT]){
+    double value = 0;
+    for (int f = 0; f < FEATURE_COUNT; f++) {
+        value += weights.feature[f] * features[f];
+    }
+    return value;
+}
+
+BoardEvaluator::BoardEvaluator(BatchIsa requested_isa){
+    BatchIsa best = bestBatchIsa();
+    isa = requested_isa > best ? best : requested_isa;
+    switch (isa) {
+#ifdef EVAL_HAS_AVX2
+        case BATCH_AVX2:
+            kernel = kernelAvx2;
+            break;
+#endif
+        case BATCH_SSE2:
+            kernel = kernelSse2;
+            break;
+        default:
+            kernel = kernelScalar;
+            break;
+    }
+    memset(&data, 0, sizeof(data));
+    data_top = Board::Height;
+}
+
+void BoardEvaluator::load(int lane, const BoardView &board){
+    int height = loadLane(data, lane, board, data_top);
+    if (height > batch_top) batch_top = height;
+    loaded |= 1u << lane;
+}
+
+void BoardEvaluator::run(int count, double *values){
+    kernel(data, batch_top);
+    for (int lane = 0; lane < count; lane++) {
+        int features[FEATURE_COUNT];
+        for (int f = 0; f < FEATURE_COUNT; f++) {
+            features[f] = data.features[f][lane];
+        }
+        values[lane] = weighFeatures(weights, features);
+    }
+
+    // Lanes que não foram carregadas continuam com as linhas antigas
+    if (loaded == (1u << Lanes) - 1 || batch_top > data_top) data_top = batch_top;
+    batch_top = 0;
+    loaded = 0;
+}
+
+void BoardEvaluator::evaluate(const BoardView *boards, int count, double *values){
+    for (int start = 0; start < count; start += Lanes) {
+        int n = count - start < Lanes ? count - start : Lanes;
+        for (int lane = 0; lane < n; lane++) {
+            load(lane, boards[start + lane]);
+        }
+        run(n, values + start);
+    }
+}
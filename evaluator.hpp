@@ -0,0 +1,89 @@
+#ifndef EVALUATOR_HPP
+#define EVALUATOR_HPP
+
+#include <stdint.h>
+#include "batch.hpp"
+#include "game.hpp"
+
+// Características de um tabuleiro 10x20, todas inteiras e calculadas sobre
+// as máscaras de linha (popcount de palavras, sem laço por célula)
+enum BoardFeature {
+    FEATURE_HEIGHT,             // Soma das alturas das colunas
+    FEATURE_HOLES,              // Células vazias sob algum bloco
+    FEATURE_COVERED,            // Blocos com algum buraco abaixo na mesma coluna
+    FEATURE_BUMPINESS,          // Diferença de altura entre colunas vizinhas
+    FEATURE_ROW_TRANSITIONS,    // Cheio/vazio ao longo das linhas até o topo (paredes cheias)
+    FEATURE_COLUMN_TRANSITIONS, // Cheio/vazio ao longo das colunas (chão cheio)
+    FEATURE_WELLS,              // Profundidade dos poços (paredes contam como colunas cheias)
+    FEATURE_UNIFORM_PAPER,      // Soma de preenchimento² das linhas só de PAPER
+    FEATURE_UNIFORM_PLASTIC,    // ... e assim por diante, na ordem de TrashType
+    FEATURE_UNIFORM_METAL,
+    FEATURE_UNIFORM_GLASS,
+    FEATURE_UNIFORM_ORGANIC,
+    FEATURE_COUNT
+};
+
+// Peso de cada característica; o valor de um tabuleiro é a soma de
+// peso x característica, na ordem de BoardFeature
+struct EvalWeights {
+    double feature[FEATURE_COUNT] = {};
+};
+
+// Tabuleiros intercalados como em BatchLanes: o elemento [y][lane] é a
+// linha y daquela lane, e as características saem no mesmo formato
+template<int K>
+struct EvalLanes {
+    static const int Height = Board::Height;
+
+    alignas(64) uint16_t rows[Height][K];
+    alignas(64) uint16_t planes[Board::TypePlanes][Height][K];
+    alignas(64) uint16_t features[FEATURE_COUNT][K];
+};
+
+// Características de um tabuleiro só (mesmo kernel, uma lane)
+void boardFeatures(const BoardView &board, int out[FEATURE_COUNT]);
+
+// Soma ponderada de características já calculadas
+double weighFeatures(const EvalWeights &weights, const int features[FEATURE_COUNT]);
+
+// Avaliador em lote: Lanes tabuleiros por chamada do kernel, intercalados
+// como em BoardBatch (linha y de todos os tabuleiros contígua). O kernel é o
+// mesmo em AVX2, SSE2 e escalar, escolhido em tempo de execução; as
+// características são inteiras, então o valor não depende do conjunto de
+// instruções.
+class BoardEvaluator{
+    public:
+        static const int Lanes = 16;
+        static const int Width = Board::Width;
+        static const int Height = Board::Height;
+
+        explicit BoardEvaluator(BatchIsa isa = bestBatchIsa());
+
+        BatchIsa getIsa() const { return isa; }
+
+        const EvalWeights &getWeights() const { return weights; }
+        void setWeights(const EvalWeights &new_weights) { weights = new_weights; }
+
+        // values[i] = valor de boards[i], para qualquer count; igual, bit a
+        // bit, a weighFeatures sobre boardFeatures
+        void evaluate(const BoardView *boards, int count, double *values);
+
+        // Lote montado aos poucos: load copia o tabuleiro para a lane (a
+        // view pode deixar de valer logo depois) e run avalia as lanes
+        // [0, count), todas carregadas desde o último run
+        void load(int lane, const BoardView &board);
+        void run(int count, double *values);
+
+    private:
+        typedef void (*Kernel)(EvalLanes<Lanes> &lanes, int top);
+
+        BatchIsa isa;
+        Kernel kernel;
+        EvalWeights weights;
+        EvalLanes<Lanes> data;
+        int data_top;      // Linhas acima dessa já estão vazias em todas as lanes
+        int batch_top = 0; // Topo mais alto carregado desde o último run
+        uint32_t loaded = 0; // Lanes carregadas desde o último run
+};
+
+#endif // EVALUATOR_HPP
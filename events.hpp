@@ -0,0 +1,84 @@
+#ifndef EVENTS_HPP
+#define EVENTS_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include "board.hpp"
+
+// Eventos publicados pelo jogo. Quem desenha, conta conquistas, grava
+// replays ou sincroniza pela rede reage a eles em vez de consultar os
+// getters a cada quadro.
+enum GameEventType : uint8_t {
+    EVENT_GAME_RESET,    // restart(): partida nova, estado todo recomeça
+    EVENT_PIECE_SPAWNED, // Peça nova em jogo (também a que sai do hold)
+    EVENT_PIECE_LOCKED,  // Peça travada no tabuleiro, antes da limpeza
+    EVENT_LINES_CLEARED, // Linhas cheias removidas na trava
+    EVENT_LEVEL_UP,
+    EVENT_COMBO_CHANGED,
+    EVENT_HOLD_USED,
+    EVENT_GAME_OVER
+};
+
+// Evento de tamanho fixo; cada tipo usa só os campos indicados
+struct GameEvent {
+    GameEventType type;
+    int8_t shape, rotation, x, y; // PIECE_*: peça e posição; HOLD_USED: forma guardada
+    int8_t lines;                 // LINES_CLEARED: quantas linhas saíram
+    int8_t rows[4];               // LINES_CLEARED: linha de cada uma antes da remoção
+    uint8_t types[4];             // LINES_CLEARED: tipo de cada uma (NONE = mista)
+    int32_t value;                // LINES_CLEARED: pontos; LEVEL_UP: nível; COMBO_CHANGED: combo
+    int32_t pieces;               // Peças travadas até o evento
+};
+
+// Fila circular de capacidade fixa, sem trava, para um produtor e um
+// consumidor (podem estar em threads diferentes). Cheia, a fila descarta o
+// evento novo e conta a perda: o produtor nunca espera.
+template<typename T, int N>
+class EventRing{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "a capacidade deve ser potência de 2");
+
+    public:
+        static const int Capacity = N;
+
+        // Lado do produtor
+        bool push(const T &item) {
+            uint32_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) == (uint32_t)N) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            slots[h & (N - 1)] = item;
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Lado do consumidor
+        bool pop(T &item) {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            if (t == head.load(std::memory_order_acquire)) return false;
+            item = slots[t & (N - 1)];
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Descarta o que ainda não foi lido (lado do consumidor)
+        void clear() { tail.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+
+        int size() const {
+            return (int)(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+        }
+        uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        // Índices em linhas de cache separadas: produtor e consumidor não
+        // disputam a mesma linha
+        alignas(64) std::atomic<uint32_t> head{0};
+        alignas(64) std::atomic<uint32_t> tail{0};
+        alignas(64) std::atomic<uint32_t> dropped{0};
+        T slots[N];
+};
+
+// Fila de eventos de uma partida: folga para muitos ticks sem leitura
+typedef EventRing<GameEvent, 256> GameEventRing;
+
+#endif // EVENTS_HPP
@@ -0,0 +1,61 @@
+#ifndef FIXED_CLOCK_HPP
+#define FIXED_CLOCK_HPP
+
+#include <stdint.h>
+#include <chrono>
+
+// Relógio de passo fixo da simulação. O tempo real de cada quadro entra num
+// acumulador e sai em ticks de duração fixa, então a gravidade e os efeitos
+// avançam o mesmo tanto por segundo real, não importa o atraso do timer da
+// GLUT, a carga da máquina ou o custo do desenho. Depois de um travamento os
+// ticks atrasados são recuperados, no máximo max_ticks_per_frame por quadro;
+// um atraso maior que max_backlog é descartado (máquina suspensa, depurador).
+// O acumulador é inteiro (nanossegundos vezes ticks por segundo), então a
+// mesma sequência de intervalos sempre gera a mesma sequência de ticks.
+class FixedStepClock{
+    public:
+        typedef std::chrono::nanoseconds Duration;
+
+        explicit FixedStepClock(int ticks_per_second = 60, int max_ticks_per_frame = 30,
+                                Duration max_backlog = std::chrono::seconds(1))
+            : ticks_per_second(ticks_per_second), max_ticks_per_frame(max_ticks_per_frame),
+              max_backlog(max_backlog.count() * ticks_per_second) {}
+
+        // Descarta o tempo acumulado (pausa, menu, reinício)
+        void reset() { accumulator = 0; }
+
+        // Soma o tempo real decorrido e devolve quantos ticks simular agora
+        int advance(Duration elapsed){
+            if (elapsed.count() > 0) accumulator += elapsed.count() * ticks_per_second;
+            if (accumulator > max_backlog) accumulator = max_backlog;
+
+            int64_t ticks = accumulator / TICK_UNITS;
+            if (ticks > max_ticks_per_frame) ticks = max_ticks_per_frame;
+            accumulator -= ticks * TICK_UNITS;
+            tick_count += ticks;
+            return (int)ticks;
+        }
+
+        // Fração (0 a 1) do próximo tick já decorrida, para o desenho
+        // interpolar entre o último estado simulado e o seguinte
+        double getAlpha() const {
+            double alpha = (double)accumulator / TICK_UNITS;
+            return alpha < 1.0 ? alpha : 1.0;
+        }
+
+        int getTicksPerSecond() const { return ticks_per_second; }
+        double getTickSeconds() const { return 1.0 / ticks_per_second; }
+        uint64_t getTickCount() const { return tick_count; }
+
+    private:
+        // Um tick no acumulador: um segundo em nanossegundos
+        static const int64_t TICK_UNITS = 1000000000;
+
+        int ticks_per_second;
+        int max_ticks_per_frame;
+        int64_t max_backlog;
+        int64_t accumulator = 0;
+        uint64_t tick_count = 0;
+};
+
+#endif // FIXED_CLOCK_HPP
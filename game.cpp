@@ -1,100 +1,33 @@
 #include "game.hpp"
 #include <time.h>
 #include <stdlib.h>
-#include <ostream>
 #include <cmath>
-#include <iostream>
 #include <algorithm>
-#define GL_CLAMP_TO_EDGE 0x812F
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#ifndef GL_CLAMP_TO_EDGE
-#define GL_CLAMP_TO_EDGE 0x812F
-#endif
-
-// Definição de todas as peças (tetrominos) e suas rotações
-const int shapes[7][4][6] = 
-{
-    {
-        {-2, 0, -1, 0, 1, 0}, //I shape 
-        {0, -2, 0, -1, 0, 1},
-        {2, 0, 1, 0, -1, 0},
-        {0, 2, 0, 1, 0, -1}
-    },
-    {
-        {-1, -1, 0, -1, 1, 0}, //S shape
-        {1, -1, 1, 0, 0, 1},
-        {1, 1, 0, 1, -1, 0},
-        {-1, 1, -1, 0, 0, -1}
-    },
-    {
-        {-1, 1, 0, 1, 1, 0}, //reverse S shape
-        {-1, -1, -1, 0, 0, 1},
-        {1, -1, 0, -1, -1, 0},
-        {1, 1, 1, 0, 0, -1}
-    },
-    {
-        {-1, -1, -1, 0, 1, 0}, //L shape
-        {1, -1, 0, -1, 0, 1},
-        {1, 1, 1, 0, -1, 0},
-        {-1, 1, 0, 1, 0, -1}
-    },
-    {
-        {-1, 1, -1, 0, 1, 0}, //reverse L shape
-        {-1, -1, 0, -1, 0, 1},
-        {1, -1, 1, 0, -1, 0},
-        {1, 1, 0, 1, 0, -1}
-    },
-    {
-        {-1, 0, 0, -1, 1, 0}, //T shape
-        {0, -1, 1, 0, 0, 1},
-        {1, 0, 0, 1, -1, 0},
-        {0, 1, -1, 0, 0, -1}
-    },
-    {
-        {0, -1, -1, -1, -1, 0}, //square shape
-        {0, -1, -1, -1, -1, 0},
-        {0, -1, -1, -1, -1, 0},
-        {0, -1, -1, -1, -1, 0}
-    }
-};
-
-// Inicialização das variáveis estáticas
-GLuint Game::texture_ids[5] = {0, 0, 0, 0, 0};
-bool Game::textures_loaded = false;
-
-Game::Game(){
-    board.resize(10);
-    for(int k = 0; k<10; k++){
-        board[k].resize(20);
-    }
-    for(int y=0; y<20; y++){
-        for(int x=0; x<10; x++){
-            board[x][y].isOccupied = false;
-            board[x][y].isCurrent = false;
-            board[x][y].combo_id = -1;
-        }
-    }
+#include <string.h>
+#include <chrono>
+
+template<int W, int H>
+BasicGame<W, H>::BasicGame(){
+    board.clear();
+    seed((uint64_t)time(NULL) ^ (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
     generateNextPiece();
-    srand(time(NULL));
 }
 
-Game::~Game(){
+template<int W, int H>
+BasicGame<W, H>::BasicGame(uint64_t seed_value){
     board.clear();
+    seed(seed_value);
+    generateNextPiece();
 }
 
-void Game::restart(){
-    board.resize(10);
-    for(int k = 0; k<10; k++){
-        board[k].resize(20);
-    }
-    for(int y=0; y<20; y++){
-        for(int x=0; x<10; x++){
-            board[x][y].isOccupied = false;
-            board[x][y].isCurrent = false;
-            board[x][y].combo_id = -1;
-        }
-    }
+template<int W, int H>
+BasicGame<W, H>::~BasicGame(){
+}
+
+template<int W, int H>
+void BasicGame<W, H>::restart(){
+    board.clear();
+    has_active_piece = false;
     game_over = false;
     
     // Reset das variáveis de pontuação e progressão
@@ -102,6 +35,7 @@ void Game::restart(){
     level = 1;
     lines_cleared = 0;
     combo_count = 0;
+    pieces_placed = 0;
     for(int i = 0; i < 5; i++) {
         recycled_count[i] = 0;
     }
@@ -110,68 +44,95 @@ void Game::restart(){
     hold_shape = -1;
     can_hold = true;
     
-    // Reset das variáveis de animação
-    line_clearing = false;
-    animation_step = 0;
-    line_being_cleared = -1;
-    line_trash_type = PAPER;
-    
-    // Limpar partículas
+    // Limpar efeitos
     particles.clear();
+    publish(GameEvent{EVENT_GAME_RESET});
     
     generateNextPiece();
     spawnTrashes();
 }
 
-bool Game::getGameOver() const {
+template<int W, int H>
+bool BasicGame<W, H>::getGameOver() const {
     return game_over; 
 }
 
-bool Game::getCurrent(int x, int y) const {
-    return board[x][y].isCurrent;
+// A peça em movimento não é gravada no tabuleiro: é composta com as
+// células travadas apenas quando alguém consulta ou desenha
+template<int W, int H>
+bool BasicGame<W, H>::getCurrent(int x, int y) const {
+    return currentCellIndex(x, y) >= 0;
+}
+
+// Índice (0 a 3) da célula da peça atual em (x, y), ou -1
+template<int W, int H>
+int BasicGame<W, H>::currentCellIndex(int x, int y) const {
+    if (!has_active_piece) return -1;
+    for (int c = 0; c < 4; c++) {
+        if (curr_x + pieceCellX(curr_shape, curr_rotation, c) == x &&
+            curr_y + pieceCellY(curr_shape, curr_rotation, c) == y) {
+            return c;
+        }
+    }
+    return -1;
 }
 
-bool Game::getOccupied(int x, int y) const {
-    return board[x][y].isOccupied;
+template<int W, int H>
+bool BasicGame<W, H>::getOccupied(int x, int y) const {
+    return board.isOccupied(x, y);
 }
 
-float Game::getRed(int x, int y) const {
-    return board[x][y].red;
+// As cores de backup são derivadas do tipo de lixo da célula
+template<int W, int H>
+float BasicGame<W, H>::getRed(int x, int y) const {
+    return getRGB(static_cast<Color>(board.getType(x, y)), 0);
 }
 
-float Game::getGreen(int x, int y) const {
-    return board[x][y].green;
+template<int W, int H>
+float BasicGame<W, H>::getGreen(int x, int y) const {
+    return getRGB(static_cast<Color>(board.getType(x, y)), 1);
 }
 
-float Game::getBlue(int x, int y) const {
-    return board[x][y].blue;
+template<int W, int H>
+float BasicGame<W, H>::getBlue(int x, int y) const {
+    return getRGB(static_cast<Color>(board.getType(x, y)), 2);
 }
 
-float Game::getRGB(Color color, int RGB) const {
+template<int W, int H>
+float BasicGame<W, H>::getRGB(Color color, int RGB) const {
     if (color >= 0 && color < 5 && RGB >= 0 && RGB < 3) {
         return colors[color][RGB];
     }
     return 0.0f;
 }
 
-void Game::setCurrent(int x, int y){
-    clearPreviousFrame();
+template<int W, int H>
+void BasicGame<W, H>::setCurrent(int x, int y){
     curr_x = x;
     curr_y = y;
-    updateActiveTrashes();
 }
 
-void Game::generateNextPiece() {
-    next_shape = rand() % 7;
-    TrashType trash_type = static_cast<TrashType>(rand() % 5);
+// Reinicia os fluxos de números aleatórios. Depois de seed(s) + restart()
+// a partida é reproduzível: efeitos visuais usam um fluxo separado e não
+// alteram a sequência de peças.
+template<int W, int H>
+void BasicGame<W, H>::seed(uint64_t seed_value) {
+    current_seed = seed_value;
+    rng.seed(seed_value, GAMEPLAY_STREAM);
+    fx_rng.seed(seed_value, EFFECTS_STREAM);
+}
+
+template<int W, int H>
+void BasicGame<W, H>::generateNextPiece() {
+    next_shape = rng.below(7);
+    TrashType trash_type = static_cast<TrashType>(rng.below(5));
     for(int i = 0; i < 4; i++){
         next_trash_types[i] = trash_type;
     }
 }
 
-void Game::spawnTrashes(){
-    if (line_clearing) return;
-    
+template<int W, int H>
+void BasicGame<W, H>::spawnTrashes(){
     // Usar a próxima peça gerada
     curr_shape = next_shape;
     for(int i = 0; i < 4; i++){
@@ -181,25 +142,31 @@ void Game::spawnTrashes(){
     // Gerar nova próxima peça
     generateNextPiece();
     
-    int rotation = rand() % 4;
-    int position = (rand() % 5) + 2;
+    int rotation = rng.below(4);
+    int position = rng.below(5) + spawnMinX(Width);
     
     curr_rotation = rotation;
-    if(checkCollision(position, 17, rotation)){
+    if(checkCollision(position, spawnY(Height), rotation)){
         game_over = true;
+        has_active_piece = false;
+        publish(GameEvent{EVENT_GAME_OVER});
     }
     else{
         curr_x = position;
-        curr_y = 17;
+        curr_y = spawnY(Height);
         can_hold = true; // Permite usar hold novamente
-        updateActiveTrashes();
+        has_active_piece = true;
+        publishPiece(EVENT_PIECE_SPAWNED);
     }
 }
 
-void Game::holdPiece() {
-    if (!can_hold) return;
+template<int W, int H>
+void BasicGame<W, H>::holdPiece() {
+    if (!can_hold || !has_active_piece) return;
     
-    clearPreviousFrame();
+    GameEvent event = {EVENT_HOLD_USED};
+    event.shape = curr_shape;
+    publish(event);
     
     if (hold_shape == -1) {
         // Primeira vez usando hold
@@ -228,20 +195,26 @@ void Game::holdPiece() {
         
         // Reposicionar peça
         curr_rotation = 0;
-        curr_x = 5;
-        curr_y = 17;
+        curr_x = Width / 2;
+        curr_y = spawnY(Height);
         
         if(checkCollision(curr_x, curr_y, curr_rotation)){
             game_over = true;
-        } else {
-            updateActiveTrashes();
+            has_active_piece = false;
+            publish(GameEvent{EVENT_GAME_OVER});
+        }
+        else{
+            publishPiece(EVENT_PIECE_SPAWNED);
         }
     }
     
     can_hold = false;
 }
 
-void Game::rotate(){
+template<int W, int H>
+void BasicGame<W, H>::rotate(){
+    if (!has_active_piece) return;
+    
     int rotation;
     if(curr_rotation > 0){
         rotation = curr_rotation - 1; 
@@ -250,357 +223,217 @@ void Game::rotate(){
         rotation = 3;
     }
     if(!(checkCollision(curr_x, curr_y, rotation))){
-        clearPreviousFrame();
         curr_rotation = rotation;
-        updateActiveTrashes();
     }
 }
 
-void Game::translate(int direction){
+template<int W, int H>
+void BasicGame<W, H>::translate(int direction){
+    if (!has_active_piece) return;
+    
     int new_x = curr_x + direction;
     if(!(checkCollision(new_x, curr_y, curr_rotation))){
-        clearPreviousFrame();
         curr_x = new_x;
-        updateActiveTrashes();
     }
 }
 
-void Game::moveDown(){
-    if (line_clearing) {
-        advanceLineAnimation();
-        return;
-    }
+template<int W, int H>
+void BasicGame<W, H>::moveDown(){
+    if (!has_active_piece) return;
     
     if(!(checkCollision(curr_x, curr_y - 1, curr_rotation))){
-        clearPreviousFrame();
         curr_y -= 1;
-        updateActiveTrashes(); 
     }
     else{
-        freezeCurrent(); // Congela a peça atual
-        clearLines(); // Verifica e limpa linhas
-        spawnTrashes(); // Gera uma nova peça
+        lockCurrent();
     }
 }
 
-void Game::freezeCurrent(){
-    board[curr_x][curr_y].isOccupied = true;
-    board[curr_x][curr_y].isCurrent = false;
-    board[curr_x][curr_y].trash_type = curr_trash_types[0];
+// Linha em que a âncora da peça atual vai pousar, calculada de uma vez
+// pelas colunas do bitboard (usada pelo hard drop e pela peça fantasma)
+template<int W, int H>
+int BasicGame<W, H>::landingRow() const {
+    if (!has_active_piece) return curr_y;
+    return curr_y - board.dropDistance(pieceMask(curr_shape, curr_rotation), curr_x, curr_y);
+}
+
+// Queda instantânea: leva a peça direto à linha de pouso e a trava
+template<int W, int H>
+void BasicGame<W, H>::hardDrop(){
+    if (!has_active_piece) return;
+    
+    curr_y = landingRow();
+    lockCurrent();
+}
+
+template<int W, int H>
+void BasicGame<W, H>::lockCurrent(){
+    freezeCurrent(); // Congela a peça atual
+    clearLines(); // Verifica e limpa linhas
+    spawnTrashes(); // Gera uma nova peça
+}
+
+template<int W, int H>
+void BasicGame<W, H>::freezeCurrent(){
+    has_active_piece = false;
+    pieces_placed++;
+    board.setCell(curr_x, curr_y, true, curr_trash_types[0]);
 
     int k = 1;
     for(int i = 1; i < 6; i+=2){
         int new_x = curr_x + shapes[curr_shape][curr_rotation][i-1];
         int new_y = curr_y + shapes[curr_shape][curr_rotation][i];
         
-        board[new_x][new_y].isOccupied = true;
-        board[new_x][new_y].isCurrent = false;
-        board[new_x][new_y].trash_type = curr_trash_types[k];
+        board.setCell(new_x, new_y, true, curr_trash_types[k]);
 
         k++;
     }
-}
-
-void Game::clearLines(){
-    checkMultipleLines();
-}
-
-void Game::checkMultipleLines() {
-    if (line_clearing) return;
-    
-    std::vector<int> lines_to_clear;
-    std::vector<TrashType> line_types;
-    
-    for(int y = 0; y < 20; y++){
-        bool full = true; // Verifica se a linha está cheia
-        for(int x = 0; x < 10; x++){
-            if(!(board[x][y].isOccupied)){
-                full = false;
-                break;
-            }
+    publishPiece(EVENT_PIECE_LOCKED);
+}
+
+// Só as linhas ocupadas pela peça recém-travada podem ter ficado cheias
+template<int W, int H>
+void BasicGame<W, H>::clearLines(){
+    const PieceMask &piece = pieceMask(curr_shape, curr_rotation);
+    checkMultipleLines(curr_y + piece.min_dy, curr_y + piece.max_dy);
+}
+
+template<int W, int H>
+void BasicGame<W, H>::checkMultipleLines(int first_row, int last_row) {
+    // Uma peça ocupa no máximo 4 linhas
+    TrashType line_types[4];
+    int uniform_count = 0;
+    int previous_score = score;
+    int previous_combo = combo_count;
+    int previous_level = level;
+    
+    // Todas as linhas cheias saem já, numa única compactação: as mistas sem
+    // pontos e as uniformes recicladas. A animação da reciclagem fica com
+    // quem desenha, a partir do evento LINES_CLEARED.
+    RowSet full = board.fullRows(first_row, last_row);
+    RowSet cleared = full;
+    GameEvent event = {EVENT_LINES_CLEARED};
+    while (full) {
+        int y = lowestBit(full);
+        full &= full - 1;
+        
+        TrashType type;
+        if (!isUniformLine(y, type)) {
+            type = NONE;
         }
+        event.rows[event.lines] = y;
+        event.types[event.lines] = type;
+        event.lines++;
+        if (type == NONE) continue;
         
-        if(full){
-            TrashType type;
-            if (isUniformLine(y, type)) {
-                lines_to_clear.push_back(y);
-                line_types.push_back(type);
-            } else {
-                // Linha mista - remove imediatamente
-                deleteRow(y);
-                y--;
+        line_types[uniform_count] = type;
+        uniform_count++;
+        
+        if (effects_enabled) {
+            for (int x = 0; x < Width; x++) {
+                createRecycleEffect(x, y, type);
             }
         }
     }
+    clearRows(cleared);
     
-    if (!lines_to_clear.empty()) {
+    if (uniform_count > 0) {
         // Processar múltiplas linhas uniformes
-        if (lines_to_clear.size() > 1) {
+        if (uniform_count > 1) {
             combo_count++;
         } else {
             combo_count = 0;
         }
         
-        // Iniciar animação para a primeira linha
-        initLineAnimation(lines_to_clear[0], line_types[0]);
-        
         // Calcular pontuação para todas as linhas
-        for (size_t i = 0; i < lines_to_clear.size(); i++) {
+        for (int i = 0; i < uniform_count; i++) {
             updateScore(1, line_types[i], i > 0 || combo_count > 0);
             recycled_count[line_types[i]]++;
-            
-            // Criar efeito de partículas
-            for (int x = 0; x < 10; x++) {
-                createRecycleEffect(x, lines_to_clear[i], line_types[i]);
-            }
         }
         
-        lines_cleared += lines_to_clear.size();
+        lines_cleared += uniform_count;
         updateLevel();
     } else {
         combo_count = 0;
     }
-}
-
-void Game::checkRow(){
-    if (line_clearing) return;
-    
-    bool full;
-    TrashType type;
     
-    for(int y=0; y<20; y++){
-        full = true;
-        for(int x=0; x<10; x++){
-            if(!(board[x][y].isOccupied)){
-                full = false;
-                break;
-            }
-        }
-        if(full){
-            if (isUniformLine(y, type)) {
-                initLineAnimation(y, type);
-                return;
-            } else {
-                deleteRow(y);
-                y--;
-            }
-        }
+    if (!event_ring) return;
+    if (event.lines > 0) {
+        event.value = score - previous_score;
+        publish(event);
     }
-}
-
-void Game::deleteRow(int y){
-    for(int k = y; k<19; k++){
-        for(int x = 0; x<10; x++){
-            board[x][k].isOccupied = board[x][k+1].isOccupied;
-            board[x][k].isCurrent = board[x][k+1].isCurrent;
-            board[x][k].trash_type = board[x][k+1].trash_type;
-            board[x][k].combo_id = board[x][k+1].combo_id;
-        }
+    if (combo_count != previous_combo) {
+        GameEvent combo = {EVENT_COMBO_CHANGED};
+        combo.value = combo_count;
+        publish(combo);
     }
-    for(int x = 0; x<10; x++){
-        board[x][19].isOccupied = false;
-        board[x][19].isCurrent = false;
-        board[x][19].combo_id = -1;
+    if (level != previous_level) {
+        GameEvent level_up = {EVENT_LEVEL_UP};
+        level_up.value = level;
+        publish(level_up);
     }
 }
 
-void Game::clearPreviousFrame(){
-    if(curr_x < 10 && curr_x > -1 && curr_y < 20 && curr_y > -1){
-        board[curr_x][curr_y].isCurrent = false;
-    }
-    for(int i = 1; i < 6; i+=2){
-        if(curr_x+shapes[curr_shape][curr_rotation][i-1] < 10 && 
-            curr_x+shapes[curr_shape][curr_rotation][i-1] > -1 &&
-            curr_y+shapes[curr_shape][curr_rotation][i] < 20 &&
-            curr_y+shapes[curr_shape][curr_rotation][i] > -1){
-                board[curr_x+shapes[curr_shape][curr_rotation][i-1]][curr_y+shapes[curr_shape][curr_rotation][i]].isCurrent = false;
-            }
-    }
-}
-
-bool Game::checkCollision(int x, int y, int rotation){
-    int xpos[4] = {x, 
-        x+shapes[curr_shape][rotation][0], 
-        x+shapes[curr_shape][rotation][2], 
-        x+shapes[curr_shape][rotation][4]
-    };
-    int ypos[4] = {y,
-        y+shapes[curr_shape][rotation][1],
-        y+shapes[curr_shape][rotation][3],
-        y+shapes[curr_shape][rotation][5]
-    };
-    for(int i=0; i<4; i++){
-        if(xpos[i] > 9 || xpos[i] < 0 || ypos[i] > 19 || ypos[i] < 0){
-            return true;
-        }
-        if(board[xpos[i]][ypos[i]].isOccupied){
-            return true;
-        }
-    }
-    return false;
+// Remove as linhas marcadas (bit y = linha y) numa única passada
+template<int W, int H>
+void BasicGame<W, H>::clearRows(RowSet rows){
+    if (!rows) return;
+    
+    board.clearRows(rows);
 }
 
-void Game::updateActiveTrashes(){
-    if(curr_x >= 0 && curr_x < 10 && curr_y >= 0 && curr_y < 20){
-        board[curr_x][curr_y].isCurrent = true;
-        if(!board[curr_x][curr_y].isOccupied){
-            board[curr_x][curr_y].trash_type = curr_trash_types[0];
-
-        }
-    }
-    
-    int k = 1;
-    for(int i = 1; i < 6; i+=2){
-        int new_x = curr_x + shapes[curr_shape][curr_rotation][i-1];
-        int new_y = curr_y + shapes[curr_shape][curr_rotation][i];
-        
-        if(new_x >= 0 && new_x < 10 && new_y >= 0 && new_y < 20){
-            board[new_x][new_y].isCurrent = true;
-            if(!board[new_x][new_y].isOccupied){
-                board[new_x][new_y].trash_type = curr_trash_types[k];
-            }
-        }
-        k++;
-    }
+template<int W, int H>
+bool BasicGame<W, H>::checkCollision(int x, int y, int rotation){
+    return board.collides(pieceMask(curr_shape, rotation), x, y);
 }
 
-void Game::dropTrashes(){
+template<int W, int H>
+void BasicGame<W, H>::dropTrashes(){
     if(!(checkCollision(curr_x, curr_y, curr_rotation))){
         freezeCurrent();
         spawnTrashes();
     }
     else{
         game_over = true;
+        publish(GameEvent{EVENT_GAME_OVER});
     }
 }
 
-TrashType Game::getTrashType(int x, int y) const {
-    if (x >= 0 && x < 10 && y >= 0 && y < 20) {
-        return board[x][y].trash_type;
+template<int W, int H>
+TrashType BasicGame<W, H>::getTrashType(int x, int y) const {
+    if (x >= 0 && x < Width && y >= 0 && y < Height) {
+        int cell = currentCellIndex(x, y);
+        if (cell >= 0) return curr_trash_types[cell];
+        if (board.isOccupied(x, y)) return board.getType(x, y);
     }
     return NONE;
 }
 
-bool Game::isUniformLine(int y, TrashType &type) {
-    if (!board[0][y].isOccupied) return false;
-    
-    type = board[0][y].trash_type;
-    
-    for (int x = 1; x < 10; x++) {
-        if (!board[x][y].isOccupied) return false;
-        if (board[x][y].trash_type != type) return false;
-    }
-    
-    return true;
-}
-
-void Game::loadTextures() {
-    if (textures_loaded) return;
-    
-    stbi_set_flip_vertically_on_load(true);
-    glGenTextures(5, texture_ids);
-    
-    const char* texture_files[5] = {
-        "textures/paper.png",
-        "textures/plastic.png",
-        "textures/metal.png",
-        "textures/glass.png",
-        "textures/organic.png"
-    };
-    
-    for (int i = 0; i < 5; i++) {
-        int width, height, channels;
-        unsigned char* data = stbi_load(texture_files[i], &width, &height, &channels, 0);
-        
-        if (data) {
-            glBindTexture(GL_TEXTURE_2D, texture_ids[i]);
-            
-            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            
-            stbi_image_free(data);
-            std::cout << "Textura carregada: " << texture_files[i] << std::endl;
-        } else {
-            std::cout << "Erro ao carregar textura: " << texture_files[i] << std::endl;
-        }
-    }
-    
-    textures_loaded = true;
-    std::cout << "Texturas carregadas com sucesso!" << std::endl;
-}
-
-void Game::bindTexture(TrashType type) {
-    if (!textures_loaded) {
-        loadTextures();
-    }
-    
-    if (type >= 0 && type < 5) {
-        glBindTexture(GL_TEXTURE_2D, texture_ids[type]);
-    }
-}
-
-void Game::initLineAnimation(int y, TrashType type) {
-    line_clearing = true;
-    line_being_cleared = y;
-    line_trash_type = type;
-    animation_step = 0;
+template<int W, int H>
+bool BasicGame<W, H>::isUniformLine(int y, TrashType &type) {
+    return board.isUniform(y, type);
 }
 
-void Game::advanceLineAnimation() {
-    if (!line_clearing) return;
-    
-    animation_step++;
-    
-    if (animation_step >= 10) {
-        deleteRow(line_being_cleared);
-        line_clearing = false;
-        animation_step = 0;
-        line_being_cleared = -1;
-        line_trash_type = PAPER;
-        
-        checkRow();
-    }
+template<int W, int H>
+void BasicGame<W, H>::updateScore(int lines, TrashType type, bool is_combo) {
+    score += recyclePoints(rules, type, lines, level, combo_count, is_combo);
 }
 
-void Game::updateScore(int lines, TrashType type, bool is_combo) {
-    int base_points = base_scores[type] * lines;
-    
-    // Multiplicador de nível
-    float level_multiplier = 1.0f + (level - 1) * 0.1f;
-    
-    // Multiplicador de combo
-    float combo_multiplier = 1.0f + combo_count * 0.2f;
-    
-    // Bônus por linha uniforme
-    float uniform_bonus = 1.5f;
-    
-    int points = (int)(base_points * level_multiplier * combo_multiplier * uniform_bonus);
-    
-    if (is_combo) {
-        points = (int)(points * 1.5f); // Bônus adicional para combos
-    }
-    
-    score += points;
-}
-
-void Game::updateLevel() {
-    int new_level = (lines_cleared / 10) + 1;
+template<int W, int H>
+void BasicGame<W, H>::updateLevel() {
+    int new_level = levelForLines(rules, lines_cleared);
     if (new_level > level) {
         level = new_level;
-        std::cout << "Nível " << level << " alcançado!" << std::endl;
     }
 }
 
-float Game::getDifficultyMultiplier() const {
-    return std::max(0.1f, 1.0f - (level - 1) * 0.05f);
+template<int W, int H>
+float BasicGame<W, H>::getDifficultyMultiplier() const {
+    return std::max(rules.min_difficulty, 1.0f - (level - 1) * rules.difficulty_step);
 }
 
-std::string Game::getTrashTypeName(TrashType type) const {
+template<int W, int H>
+std::string BasicGame<W, H>::getTrashTypeName(TrashType type) const {
     switch (type) {
         case PAPER: return "Papel";
         case PLASTIC: return "Plástico";
@@ -611,21 +444,23 @@ std::string Game::getTrashTypeName(TrashType type) const {
     }
 }
 
-void Game::createRecycleEffect(int x, int y, TrashType type) {
+template<int W, int H>
+void BasicGame<W, H>::createRecycleEffect(int x, int y, TrashType type) {
     for (int i = 0; i < 3; i++) {
         Particle p;
         p.x = x + 0.5f;
         p.y = y + 0.5f;
-        p.vx = ((rand() % 200) - 100) / 100.0f;
-        p.vy = ((rand() % 200) - 100) / 100.0f;
+        p.vx = ((int)fx_rng.below(200) - 100) / 100.0f;
+        p.vy = ((int)fx_rng.below(200) - 100) / 100.0f;
         p.life = 1.0f;
-        p.size = 0.1f + (rand() % 20) / 100.0f;
+        p.size = 0.1f + fx_rng.below(20) / 100.0f;
         p.type = type;
         particles.push_back(p);
     }
 }
 
-void Game::updateParticles() {
+template<int W, int H>
+void BasicGame<W, H>::updateParticles() {
     for (auto it = particles.begin(); it != particles.end();) {
         it->x += it->vx * 0.016f; // 60 FPS
         it->y += it->vy * 0.016f;
@@ -640,22 +475,48 @@ void Game::updateParticles() {
     }
 }
 
-void Game::update() {
+template<int W, int H>
+void BasicGame<W, H>::update() {
     updateParticles();
 }
 
+template<int W, int H>
+void BasicGame<W, H>::setEffectsEnabled(bool enabled) {
+    effects_enabled = enabled;
+    if (!enabled) {
+        particles.clear();
+    }
+}
+
+template<int W, int H>
+void BasicGame<W, H>::publish(GameEvent event) {
+    if (!event_ring) return;
+    event.pieces = pieces_placed;
+    event_ring->push(event);
+}
+
+template<int W, int H>
+void BasicGame<W, H>::publishPiece(GameEventType type) {
+    if (!event_ring) return;
+    GameEvent event = {type};
+    event.shape = curr_shape;
+    event.rotation = curr_rotation;
+    event.x = curr_x;
+    event.y = curr_y;
+    publish(event);
+}
+
 // save/load system
-void Game::setCell(int x, int y, bool occupied, TrashType type, float r, float g, float b) {
-    if (x >= 0 && x < 10 && y >= 0 && y < 20) {
-        board[x][y].isOccupied = occupied;
-        board[x][y].trash_type = type;
-        board[x][y].red = r;
-        board[x][y].green = g;
-        board[x][y].blue = b;
+// r, g, b mantidos por compatibilidade: a cor é derivada do tipo
+template<int W, int H>
+void BasicGame<W, H>::setCell(int x, int y, bool occupied, TrashType type, float r, float g, float b) {
+    if (x >= 0 && x < Width && y >= 0 && y < Height) {
+        board.setCell(x, y, occupied, type);
     }
 }
 
-void Game::setCurrentPiece(int shape, int rotation, int x, int y, TrashType types[4]) {
+template<int W, int H>
+void BasicGame<W, H>::setCurrentPiece(int shape, int rotation, int x, int y, TrashType types[4]) {
     curr_shape = shape;
     curr_rotation = rotation;
     curr_x = x;
@@ -663,16 +524,19 @@ void Game::setCurrentPiece(int shape, int rotation, int x, int y, TrashType type
     for (int i = 0; i < 4; i++) {
         curr_trash_types[i] = types[i];
     }
+    has_active_piece = true;
 }
 
-void Game::setNextPiece(int shape, TrashType types[4]) {
+template<int W, int H>
+void BasicGame<W, H>::setNextPiece(int shape, TrashType types[4]) {
     next_shape = shape;
     for (int i = 0; i < 4; i++) {
         next_trash_types[i] = types[i];
     }
 }
 
-void Game::setHoldPiece(int shape, TrashType types[4], bool can_hold_flag) {
+template<int W, int H>
+void BasicGame<W, H>::setHoldPiece(int shape, TrashType types[4], bool can_hold_flag) {
     hold_shape = shape;
     for (int i = 0; i < 4; i++) {
         hold_trash_types[i] = types[i];
@@ -681,7 +545,98 @@ void Game::setHoldPiece(int shape, TrashType types[4], bool can_hold_flag) {
 }
 
 // métodos não utilizados
-void Game::checkFruits() {}
-void Game::checkFruit(int x, int y) {}
-TrashType Game::getTrashTypeFromColor(float r, float g, float b) { return PAPER; }
-std::vector< std::vector<Space> > Game::getBoard() { return board; }
+template<int W, int H>
+void BasicGame<W, H>::checkFruits() {}
+template<int W, int H>
+void BasicGame<W, H>::checkFruit(int x, int y) {}
+template<int W, int H>
+TrashType BasicGame<W, H>::getTrashTypeFromColor(float r, float g, float b) { return PAPER; }
+
+// Tipos das quatro células de uma peça em 12 bits
+static uint64_t typesCode(const TrashType types[4]) {
+    uint64_t code = 0;
+    for (int i = 0; i < 4; i++) code |= (uint64_t)types[i] << (3 * i);
+    return code;
+}
+
+// Domínios de chaves separados dos índices das células do tabuleiro
+static const uint64_t ZOBRIST_CURRENT = 1ULL << 40;
+static const uint64_t ZOBRIST_NEXT = 2ULL << 40;
+static const uint64_t ZOBRIST_HOLD = 3ULL << 40;
+
+template<int W, int H>
+uint64_t BasicGame<W, H>::getHash() const {
+    uint64_t hash = board.getHash();
+    if (has_active_piece) {
+        uint64_t placement = (((uint64_t)curr_shape * 4 + curr_rotation) * 256 + (uint8_t)curr_x) * 256 + (uint8_t)curr_y;
+        hash ^= zobristKey(ZOBRIST_CURRENT + (placement << 12 | typesCode(curr_trash_types)));
+    }
+    hash ^= zobristKey(ZOBRIST_NEXT + ((uint64_t)next_shape << 12 | typesCode(next_trash_types)));
+    uint64_t hold = (uint64_t)(hold_shape + 1) * 2 + (can_hold ? 1 : 0);
+    hash ^= zobristKey(ZOBRIST_HOLD + (hold << 12 | typesCode(hold_trash_types)));
+    return hash;
+}
+
+// save/load em memória: retrato e restauração do estado completo
+template<int W, int H>
+BasicGameState<W, H> BasicGame<W, H>::snapshot() const {
+    BasicGameState<W, H> state;
+    state.board = board;
+    state.rng = rng;
+    state.score = score;
+    state.level = level;
+    state.lines_cleared = lines_cleared;
+    state.combo_count = combo_count;
+    state.pieces_placed = pieces_placed;
+    for (int i = 0; i < 5; i++) {
+        state.recycled_count[i] = recycled_count[i];
+    }
+    state.curr_shape = curr_shape;
+    state.curr_rotation = curr_rotation;
+    state.curr_x = curr_x;
+    state.curr_y = curr_y;
+    state.next_shape = next_shape;
+    state.hold_shape = hold_shape;
+    for (int i = 0; i < 4; i++) {
+        state.curr_types[i] = curr_trash_types[i];
+        state.next_types[i] = next_trash_types[i];
+        state.hold_types[i] = hold_trash_types[i];
+    }
+    state.has_active_piece = has_active_piece;
+    state.can_hold = can_hold;
+    state.game_over = game_over;
+    return state;
+}
+
+template<int W, int H>
+void BasicGame<W, H>::restore(const BasicGameState<W, H> &state) {
+    board = state.board;
+    rng = state.rng;
+    score = state.score;
+    level = state.level;
+    lines_cleared = state.lines_cleared;
+    combo_count = state.combo_count;
+    pieces_placed = state.pieces_placed;
+    for (int i = 0; i < 5; i++) {
+        recycled_count[i] = state.recycled_count[i];
+    }
+    curr_shape = state.curr_shape;
+    curr_rotation = state.curr_rotation;
+    curr_x = state.curr_x;
+    curr_y = state.curr_y;
+    next_shape = state.next_shape;
+    hold_shape = state.hold_shape;
+    for (int i = 0; i < 4; i++) {
+        curr_trash_types[i] = static_cast<TrashType>(state.curr_types[i]);
+        next_trash_types[i] = static_cast<TrashType>(state.next_types[i]);
+        hold_trash_types[i] = static_cast<TrashType>(state.hold_types[i]);
+    }
+    has_active_piece = state.has_active_piece;
+    can_hold = state.can_hold;
+    game_over = state.game_over;
+}
+
+// Tabuleiro clássico e as variantes largas usadas em testes de carga
+template class BasicGame<10, 20>;
+template class BasicGame<16, 40>;
+template class BasicGame<32, 64>;
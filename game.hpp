@@ -2,30 +2,16 @@
 #define GAME_HPP
 
 #include <vector>
-#include <GL/glut.h>
 #include <string>
-
-
-// Enum dos tipos de lixo para reciclagem
-enum TrashType {PAPER, PLASTIC, METAL, GLASS, ORGANIC, NONE};
-
-class Space{
-    public:
-        bool isOccupied; // True se ocupado por uma peça congelada
-        bool isCurrent;  // True se parte da peça em movimento
-        TrashType trash_type; // Tipo de lixo para determinar a textura
-        float red;       // Valores RGB para colorir a célula (backup)
-        float green;
-        float blue;
-        int combo_id = -1; // ID para identificar combos
-};
+#include <type_traits>
+#include "board.hpp"
+#include "events.hpp"
+#include "rng.hpp"
+#include "rules.hpp"
 
 // Enum das cores disponíveis para as peças
 enum Color {paper, plastic, metal, glass, organic};
 
-// Definição de todas as peças (tetrominos) e suas rotações
-extern const int shapes[7][4][6];
-
 struct Particle {
     float x, y;
     float vx, vy;
@@ -34,12 +20,61 @@ struct Particle {
     TrashType type;
 };
 
-class Game{
+// Retrato compacto de uma partida: tabuleiro travado, peças atual, próxima e
+// guardada, pontuação e gerador de peças. É trivialmente copiável, então
+// clonar ou restaurar não passa pelo alocador. Partículas, a fila de eventos
+// e o gerador de efeitos ficam de fora.
+template<int W, int H>
+struct BasicGameState {
+    BasicBoard<W, H> board; // Inclui os índices derivados: restaurar é só uma cópia
+    Rng rng;
+    int32_t score;
+    int32_t level;
+    int32_t lines_cleared;
+    int32_t combo_count;
+    int32_t pieces_placed;
+    int32_t recycled_count[5];
+    int8_t curr_shape, curr_rotation, curr_x, curr_y;
+    int8_t next_shape, hold_shape;
+    uint8_t curr_types[4], next_types[4], hold_types[4];
+    bool has_active_piece, can_hold, game_over;
+};
+
+// Motor do jogo com as dimensões do tabuleiro fixadas em tempo de
+// compilação. Game é o tabuleiro clássico 10x20; as variantes largas
+// (16x40, 32x64) são instanciadas em game.cpp para testes de carga.
+template<int W, int H>
+class BasicGame{
     public:
-        Game();
-        ~Game();
+        static const int Width = W;
+        static const int Height = H;
+        typedef BasicBoard<W, H> BoardType;
+        typedef BasicBoardView<W, H> BoardViewType;
+        typedef BasicGameState<W, H> State;
+
+        BasicGame();
+        explicit BasicGame(uint64_t seed_value);
+        ~BasicGame();
+
+        // Sementes dos geradores da partida (jogo e efeitos)
+        void seed(uint64_t seed_value);
+        uint64_t getSeed() const { return current_seed; }
+
+        // Visão sem cópia das linhas travadas (substitui getBoard)
+        BoardViewType getBoardView() const { return BoardViewType(board); }
+        
+        // Retrato e restauração do estado completo da partida
+        State snapshot() const;
+        void restore(const State &state);
+
+        // Hash de Zobrist da posição: tabuleiro travado (mantido pelo
+        // tabuleiro a cada trava e limpeza), peça atual, próxima e hold.
+        // Pontuação e gerador ficam de fora.
+        uint64_t getHash() const;
 
-        std::vector< std::vector<Space> > getBoard();
+        // Só o hash do tabuleiro travado: chave do que depende dele e de
+        // nada mais
+        uint64_t getBoardHash() const { return board.getHash(); }
         bool getGameOver() const;
         bool getOccupied(int x, int y) const;
         bool getCurrent(int x, int y) const;
@@ -52,21 +87,25 @@ class Game{
         void rotate();
         void translate(int direction);
         void moveDown();
+        void hardDrop();
+        int landingRow() const;
         void setCurrent(int x, int y);
         void dropTrashes();
         void restart();
         void update(); // Novo: atualiza partículas e efeitos
 
-        // sistema de animação de reciclagem
-        bool isLineClearing() const { return line_clearing; }
-        int getAnimationStep() const { return animation_step; }
-        int getLineBeingCleared() const { return line_being_cleared; }
-        TrashType getLineTrashType() const { return line_trash_type; }
-        
-        // texturas
-        static void loadTextures();
-        static void bindTexture(TrashType type);
+        // Partículas de reciclagem. Desligadas por padrão: sem tela a
+        // partida não gasta nada com elas.
+        void setEffectsEnabled(bool enabled);
+        bool getEffectsEnabled() const { return effects_enabled; }
+
+        // Fila onde o jogo publica seus eventos (nullptr = nenhuma, o padrão).
+        // A fila é de quem a criou; restore e os setters de save/load não
+        // publicam nada.
+        void setEventRing(GameEventRing *ring) { event_ring = ring; }
+        GameEventRing *getEventRing() const { return event_ring; }
         
+        bool hasActivePiece() const { return has_active_piece; }
         int getCurrentShape() const { return curr_shape; }
         int getCurrentRotation() const { return curr_rotation; }
         int getCurrentX() const { return curr_x; }
@@ -78,6 +117,7 @@ class Game{
         void setLevel(int l) { level = l; }
         void setLinesCleared(int lc) { lines_cleared = lc; }
         void setComboCount(int cc) { combo_count = cc; }
+        void setPiecesPlaced(int pp) { pieces_placed = pp; }
         void setRecycledCount(TrashType type, int count) { recycled_count[type] = count; }
         void setCell(int x, int y, bool occupied, TrashType type, float r, float g, float b);
         void setCurrentPiece(int shape, int rotation, int x, int y, TrashType types[4]);
@@ -85,14 +125,26 @@ class Game{
         void setHoldPiece(int shape, TrashType types[4], bool can_hold_flag);
         void setGameOver(bool go) { game_over = go; }
         
+        // índices do tabuleiro mantidos a cada trava e limpeza
+        int getColumnHeight(int x) const { return board.getColumnHeight(x); }
+        int getRowFill(int y) const { return board.getRowFill(y); }
+        int getRowTypeCount(int y, TrashType type) const { return board.getRowTypeCount(y, type); }
+        int getHoleCount() const { return board.countHoles(); }
+        
         // verificar colisão externamente
         bool checkCollision(int x, int y, int rotation);
         
+        // Regras de pontuação e dificuldade (fora do GameState: restaurar um
+        // retrato mantém as regras do jogo de destino)
+        const RulesConfig &getRules() const { return rules; }
+        void setRules(const RulesConfig &new_rules) { rules = new_rules; }
+
         // sistema de pontuação e níveis
         int getScore() const { return score; }
         int getLevel() const { return level; }
         int getLinesCleared() const { return lines_cleared; }
         int getComboCount() const { return combo_count; }
+        int getPiecesPlaced() const { return pieces_placed; }
         float getDifficultyMultiplier() const;
         std::string getTrashTypeName(TrashType type) const;
         
@@ -117,12 +169,17 @@ class Game{
         float getRGB(Color color, int RGB) const;
         
     private:
-        std::vector< std::vector<Space> > board;
-        int curr_shape;
-        int curr_rotation;
-        int curr_x;
-        int curr_y;
-        TrashType curr_trash_types[4];
+        // Conjunto de linhas do tabuleiro: bit y = linha y
+        typedef typename BoardType::ColumnMask RowSet;
+
+        BoardType board;
+        RulesConfig rules;
+        bool has_active_piece = false; // Peça em movimento (sobreposta ao tabuleiro)
+        int curr_shape = 0;
+        int curr_rotation = 0;
+        int curr_x = 0;
+        int curr_y = 0;
+        TrashType curr_trash_types[4] = {NONE, NONE, NONE, NONE};
         bool game_over = false;
         
         // Sistema de pontuação e progressão
@@ -130,34 +187,33 @@ class Game{
         int level = 1;
         int lines_cleared = 0;
         int combo_count = 0;
+        int pieces_placed = 0; // Peças travadas na partida
         int recycled_count[5] = {0, 0, 0, 0, 0}; // Contador para cada tipo de lixo
         
         // Sistema de próxima peça e hold
         int next_shape;
         TrashType next_trash_types[4];
         int hold_shape = -1;
-        TrashType hold_trash_types[4];
+        TrashType hold_trash_types[4] = {NONE, NONE, NONE, NONE};
         bool can_hold = true;
         
-        // Variáveis para animação de reciclagem
-        bool line_clearing = false;
-        int animation_step = 0;
-        int line_being_cleared = -1;
-        TrashType line_trash_type = PAPER;
-        
-        // Sistema de partículas
+        // Efeitos visuais e eventos para quem estiver ouvindo
+        bool effects_enabled = false;
         std::vector<Particle> particles;
+        GameEventRing *event_ring = nullptr;
         
-        // IDs das texturas OpenGL
-        static GLuint texture_ids[5];
-        static bool textures_loaded;
+        // Geradores próprios: um fluxo para as peças e outro para efeitos
+        static const uint64_t GAMEPLAY_STREAM = 0x5eed0001;
+        static const uint64_t EFFECTS_STREAM = 0x5eed0002;
+        uint64_t current_seed = 0;
+        Rng rng;
+        Rng fx_rng;
         
-        void updateActiveTrashes();
-        void clearPreviousFrame();
+        int currentCellIndex(int x, int y) const;
         void freezeCurrent();
+        void lockCurrent();
         void clearLines();
-        void checkRow();
-        void deleteRow(int y);
+        void clearRows(RowSet rows);
         void checkFruits();
         void checkFruit(int x, int y);
         void deleteTrashes(int x1, int y1, int x2, int y2, int x3, int y3);
@@ -165,16 +221,19 @@ class Game{
         
         // reciclagem
         bool isUniformLine(int y, TrashType &type);
-        void advanceLineAnimation();
-        void initLineAnimation(int y, TrashType type);
         TrashType getTrashTypeFromColor(float r, float g, float b);
-        void checkMultipleLines(); // Novo: verifica múltiplas linhas simultâneas
+        void checkMultipleLines(int first_row, int last_row); // Novo: verifica múltiplas linhas simultâneas
         
         // sistema de pontuação
         void updateScore(int lines_cleared, TrashType type, bool is_combo);
         void updateLevel();
         void generateNextPiece();
         void updateParticles();
+
+        // Eventos: publish completa o contador de peças; publishPiece usa a
+        // peça atual
+        void publish(GameEvent event);
+        void publishPiece(GameEventType type);
         
         // Cores de backup
         const float colors[5][3] = {
@@ -184,9 +243,17 @@ class Game{
             {0.0, 1.0, 0.0},    // GLASS - Verde
             {0.5, 0.25, 0.0}    // ORGANIC - Marrom
         };
-        
-        // Pontuações base para cada tipo de lixo
-        const int base_scores[5] = {100, 150, 200, 175, 125};
 };
 
+extern template class BasicGame<10, 20>;
+extern template class BasicGame<16, 40>;
+extern template class BasicGame<32, 64>;
+
+// Jogo clássico 10x20
+typedef BasicGame<10, 20> Game;
+typedef BasicGameState<10, 20> GameState;
+
+static_assert(std::is_trivially_copyable<Board>::value, "Board deve ser trivialmente copiável");
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState deve ser trivialmente copiável");
+
 #endif // GAME_HPP
@@ -1,11 +1,20 @@
 #include "game.hpp"
+#include "achievements.hpp"
+#include "autoplayer.hpp"
+#include "beam.hpp"
+#include "mcts.hpp"
+#include "render.hpp"
+#include "fixed_clock.hpp"
 #include <GL/glut.h>
 #include <time.h>
 #include <stdlib.h>
+#include <string.h>
 #include <string>
+#include <vector>
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <memory>
 #include <cmath>
 #include <algorithm>
 #include <iostream>
@@ -15,14 +24,87 @@ auto game_start_time = std::chrono::steady_clock::now();
 bool game_initialized = false;
 bool game_paused = false;
 
+// Relógio da simulação: a lógica roda em ticks fixos, independente do timer
+// da GLUT. A gravidade é medida em ticks (30 ticks por linha no nível 1).
+const int SIM_TICKS_PER_SECOND = 60;
+const int GRAVITY_TICKS = 30;
+FixedStepClock sim_clock(SIM_TICKS_PER_SECOND);
+int gravity_counter = 0;
+float render_alpha = 0.0f; // Fração do próximo tick, para interpolar o desenho
+
+// Modo turbo (tecla T ou --turbo): a lógica roda o mais rápido possível e a
+// tela é redesenhada só a cada turbo_draw_every ticks ou, com 0, no máximo
+// TURBO_DISPLAY_FPS vezes por segundo
+const int TURBO_DISPLAY_FPS = 30;
+bool turbo_mode = false;
+int turbo_draw_every = 0;
+
+// Jogador automático (tecla A, --autoplay, --autoplay-beam ou
+// --autoplay-mcts): uma jogada a cada AUTOPLAY_TICKS ticks. O guloso decide
+// dentro do orçamento de 1 ms do AutoPlayer; o planejador em feixe e a busca
+// Monte Carlo olham também a próxima peça e o hold, com um orçamento
+// proporcional ao intervalo da gravidade. Ligado, um game over já começa a
+// partida seguinte.
+enum AutoplayMode {
+    AUTOPLAY_OFF,
+    AUTOPLAY_GREEDY,
+    AUTOPLAY_BEAM,
+    AUTOPLAY_MCTS
+};
+
+const int AUTOPLAY_TICKS = 6;
+AutoPlayer autoplayer;
+std::unique_ptr<BeamPlanner> beam_planner; // Criados no primeiro uso: têm threads próprias
+std::unique_ptr<MctsPlanner> mcts_planner;
+AutoplayMode autoplay = AUTOPLAY_OFF;
+int autoplay_counter = 0;
+
+// Eventos do jogo, lidos uma vez por tick: painel, efeitos e conquistas só
+// trabalham quando algo acontece
+GameEventRing game_events;
+
+// Animações de reciclagem: o jogo remove a linha na hora e avisa com
+// EVENT_LINES_CLEARED; o bloco indo para a lixeira é só desenho e avança um
+// passo a cada RECYCLE_STEP_TICKS ticks, sem segurar a próxima peça
+const int RECYCLE_ANIMATION_STEPS = 10;
+const int RECYCLE_STEP_TICKS = 3;
+
+struct RecycleAnimation
+{
+    int row; // Linha que ela ocupava no momento da trava
+    TrashType type;
+    int step;
+    int ticks;
+};
+
+std::vector<RecycleAnimation> recycle_animations;
+
+// Valores do painel de estatísticas, copiados do jogo quando um evento os muda
+struct HudStats
+{
+    int score;
+    int level;
+    int lines;
+    int combo;
+    int recycled[5];
+    int achievements;
+};
+
+HudStats hud;
+
+// Aviso de conquista desbloqueada, exibido por alguns segundos
+const int ACHIEVEMENT_NOTICE_TICKS = 3 * SIM_TICKS_PER_SECOND;
+std::string achievement_notice;
+int achievement_notice_ticks = 0;
+
 // Estados do jogo
-enum GameState {
+enum ScreenState {
     MENU_MAIN,
     GAME_PLAYING,
     GAME_PAUSED
 };
 
-GameState current_state = MENU_MAIN;
+ScreenState current_state = MENU_MAIN;
 int menu_selection = 0; // 0 = Jogar, 1 = Sair
 int pause_selection = 0; // 0 = Continuar, 1 = Reiniciar, 2 = Sair
 
@@ -35,7 +117,7 @@ void drawHoldPanel();
 void drawStatsPanel();
 void drawAchievementNotifications();
 void drawComboEffects();
-void drawRecyclingAnimation();
+void drawRecyclingAnimation(const RecycleAnimation &animation);
 void drawTexturedBlock(float x, float y, TrashType type, float alpha = 1.0f, bool glow = false);
 void drawRecycleBin(float x, float y, float r, float g, float b, float scale = 1.0f, bool animated = false);
 void drawParticles();
@@ -43,6 +125,10 @@ void renderText(float x, float y, const std::string &text, void *font = GLUT_BIT
 void transform(int key, int x, int y);
 void options(unsigned char key, int x, int y);
 void timer(int id);
+void simulationTick();
+void handleGameEvent(const GameEvent &event);
+void refreshHud();
+void runTurboFrame();
 void reshape(int width, int height);
 void drawMainMenu();
 void drawPauseMenu();
@@ -56,7 +142,7 @@ void init(void)
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    Game::loadTextures();
+    TextureManager::loadTextures();
 
 }
 
@@ -73,7 +159,7 @@ void renderText(float x, float y, const std::string &text, void *font)
 // Função para desenhar um bloco com textura e efeitos
 void drawTexturedBlock(float x, float y, TrashType type, float alpha, bool glow)
 {
-    Game::bindTexture(type);
+    TextureManager::bindTexture(type);
 
     if (glow)
     {
@@ -208,8 +294,13 @@ void drawParticles()
     glDisable(GL_TEXTURE_2D);
     glEnable(GL_POINT_SMOOTH);
 
+    // Posição interpolada entre o último tick e o seguinte
+    float ahead = render_alpha * (float)sim_clock.getTickSeconds();
+
     for (const auto &p : game.getParticles())
     {
+        float px = p.x + p.vx * ahead;
+        float py = p.y + p.vy * ahead;
         float r = game.getRGB(static_cast<Color>(p.type), 0);
         float g = game.getRGB(static_cast<Color>(p.type), 1);
         float b = game.getRGB(static_cast<Color>(p.type), 2);
@@ -221,14 +312,14 @@ void drawParticles()
         glColor4f(r, g, b, p.life * 0.8f);
 
         glBegin(GL_POINTS);
-        glVertex2f(p.x, p.y);
+        glVertex2f(px, py);
         glEnd();
 
         // Rastro da partícula
         glColor4f(r, g, b, p.life * 0.3f);
         glBegin(GL_LINES);
-        glVertex2f(p.x, p.y);
-        glVertex2f(p.x - p.vx * 0.5f, p.y - p.vy * 0.5f);
+        glVertex2f(px, py);
+        glVertex2f(px - p.vx * 0.5f, py - p.vy * 0.5f);
         glEnd();
     }
 
@@ -260,60 +351,75 @@ void drawGame()
 
     glColor3f(1.0f, 1.0f, 1.0f);
 
-    // Desenhar tabuleiro principal
-    for (int y = 0; y < 20; y++)
+    // Desenhar células vazias
+    glDisable(GL_TEXTURE_2D);
+    glColor3f(0.01f, 0.01f, 0.03f);
+    for (int y = 0; y < Game::Height; y++)
     {
-        for (int x = 0; x < 10; x++)
+        for (int x = 0; x < Game::Width; x++)
         {
-            if (game.isLineClearing() && y == game.getLineBeingCleared())
+            if (!game.getOccupied(x, y))
             {
-                if (x >= game.getAnimationStep())
-                {
-                    TrashType type = game.getTrashType(x, y);
-                    if (type != NONE)
-                    {
-                        drawTexturedBlock(x, y, type, 1.0f, true); 
-                    }
-                }
-            }
-            else if (game.getOccupied(x, y) ^ game.getCurrent(x, y))
-            {
-                TrashType type = game.getTrashType(x, y);
-                if (type != NONE)
-                {
-                    bool is_current = game.getCurrent(x, y);
-                    drawTexturedBlock(x, y, type, is_current ? 0.9f : 1.0f, is_current);
-                }
+                glRectf(x, y, x + 1, y + 1);
             }
         }
     }
+    glEnable(GL_TEXTURE_2D);
 
-    // Desenhar células vazias
-    glDisable(GL_TEXTURE_2D);
-    glColor3f(0.01f, 0.01f, 0.03f);
-    for (int y = 0; y < 20; y++)
+    // Desenhar tabuleiro principal (apenas peças travadas)
+    for (int y = 0; y < Game::Height; y++)
     {
-        for (int x = 0; x < 10; x++)
+        for (int x = 0; x < Game::Width; x++)
         {
-            if (!game.getOccupied(x, y) && !game.getCurrent(x, y))
+            if (game.getOccupied(x, y))
             {
-                glRectf(x, y, x + 1, y + 1);
+                drawTexturedBlock(x, y, game.getTrashType(x, y), 1.0f, false);
             }
         }
     }
 
+    // Linhas recicladas: já saíram do tabuleiro, mas os blocos ainda não
+    // levados para a lixeira brilham onde a linha estava
+    for (const RecycleAnimation &animation : recycle_animations)
+    {
+        for (int x = animation.step; x < Game::Width; x++)
+        {
+            drawTexturedBlock(x, animation.row, animation.type, 1.0f, true);
+        }
+    }
+
+    // Peça em movimento, desenhada por cima a partir do seu estado
+    if (game.hasActivePiece())
+    {
+        int shape = game.getCurrentShape();
+        int rotation = game.getCurrentRotation();
+        int piece_x = game.getCurrentX();
+        int piece_y = game.getCurrentY();
+        TrashType *types = game.getCurrentTrashTypes();
+
+        drawTexturedBlock(piece_x, piece_y, types[0], 0.9f, true);
+        for (int i = 1; i < 6; i += 2)
+        {
+            drawTexturedBlock(piece_x + shapes[shape][rotation][i - 1],
+                              piece_y + shapes[shape][rotation][i],
+                              types[i / 2 + 1], 0.9f, true);
+        }
+    }
+
+    glDisable(GL_TEXTURE_2D);
+
     // Grade opcional
     glColor4f(0.15f, 0.15f, 0.25f, 0.6f);
     glBegin(GL_LINES);
-    for (int i = 0; i <= 10; i++)
+    for (int i = 0; i <= Game::Width; i++)
     {
         glVertex2f(i, 0.0f);
-        glVertex2f(i, 20.0f);
+        glVertex2f(i, Game::Height);
     }
-    for (int i = 0; i <= 20; i++)
+    for (int i = 0; i <= Game::Height; i++)
     {
         glVertex2f(0.0f, i);
-        glVertex2f(10.0f, i);
+        glVertex2f(Game::Width, i);
     }
     glEnd();
 
@@ -322,14 +428,35 @@ void drawGame()
     glLineWidth(3.0f);
     glBegin(GL_LINE_LOOP);
     glVertex2f(-0.1f, -0.1f);
-    glVertex2f(10.1f, -0.1f);
-    glVertex2f(10.1f, 20.1f);
-    glVertex2f(-0.1f, 20.1f);
+    glVertex2f(Game::Width + 0.1f, -0.1f);
+    glVertex2f(Game::Width + 0.1f, Game::Height + 0.1f);
+    glVertex2f(-0.1f, Game::Height + 0.1f);
     glEnd();
     glLineWidth(1.0f);
 
     glEnable(GL_TEXTURE_2D);
 
+    // Peça fantasma na linha de pouso
+    if (game.hasActivePiece())
+    {
+        int ghost_y = game.landingRow();
+        if (ghost_y < game.getCurrentY())
+        {
+            int shape = game.getCurrentShape();
+            int rotation = game.getCurrentRotation();
+            int ghost_x = game.getCurrentX();
+            TrashType *types = game.getCurrentTrashTypes();
+
+            drawTexturedBlock(ghost_x, ghost_y, types[0], 0.25f);
+            for (int i = 1; i < 6; i += 2)
+            {
+                drawTexturedBlock(ghost_x + shapes[shape][rotation][i - 1],
+                                  ghost_y + shapes[shape][rotation][i],
+                                  types[i / 2 + 1], 0.25f);
+            }
+        }
+    }
+
     // UI lateral melhorada
     drawNextPiecePanel();
     drawHoldPanel();
@@ -344,9 +471,9 @@ void drawGame()
         drawComboEffects();
 
         // Animação de reciclagem
-        if (game.isLineClearing())
+        for (const RecycleAnimation &animation : recycle_animations)
         {
-            drawRecyclingAnimation();
+            drawRecyclingAnimation(animation);
         }
     }
 }
@@ -570,6 +697,11 @@ void drawControlsPanel()
     y -= 0.4f;
     renderText(19.0f, y, "R - Reiniciar", GLUT_BITMAP_8_BY_13);
     y -= 0.4f;
+    renderText(19.0f, y, turbo_mode ? "T - Turbo (ligado)" : "T - Turbo", GLUT_BITMAP_8_BY_13);
+    y -= 0.4f;
+    const char *autoplay_labels[] = {"A - Automatico", "A - Automatico (guloso)", "A - Automatico (feixe)", "A - Automatico (MCTS)"};
+    renderText(19.0f, y, autoplay_labels[autoplay], GLUT_BITMAP_8_BY_13);
+    y -= 0.4f;
     renderText(19.0f, y, "Q - Sair", GLUT_BITMAP_8_BY_13);
     
     glEnable(GL_TEXTURE_2D);
@@ -715,7 +847,7 @@ void drawStatsPanel()
 
     // Pontuação com animação
     static int displayed_score = 0;
-    int target_score = game.getScore();
+    int target_score = hud.score;
     if (displayed_score < target_score)
     {
         displayed_score += std::max(1, (target_score - displayed_score) / 10);
@@ -727,12 +859,13 @@ void drawStatsPanel()
 
     // Nível com barra de progresso
     ss.str("");
-    ss << "NIVEL: " << game.getLevel();
+    ss << "NIVEL: " << hud.level;
     renderText(12.0f, y, ss.str());
 
     // Barra de progresso para próximo nível
-    int lines_for_next = ((game.getLevel()) * 10) - game.getLinesCleared();
-    float progress = 1.0f - (float)lines_for_next / 10.0f;
+    int lines_per_level = game.getRules().lines_per_level;
+    int lines_for_next = (hud.level * lines_per_level) - hud.lines;
+    float progress = 1.0f - (float)lines_for_next / lines_per_level;
 
     glColor3f(0.2f, 0.2f, 0.2f);
     glBegin(GL_QUADS);
@@ -755,15 +888,15 @@ void drawStatsPanel()
 
     // Outras estatísticas
     ss.str("");
-    ss << "LINHAS: " << game.getLinesCleared();
+    ss << "LINHAS: " << hud.lines;
     renderText(12.0f, y, ss.str());
     y -= 0.5f;
 
-    if (game.getComboCount() > 0)
+    if (hud.combo > 0)
     {
         glColor3f(1.0f, 1.0f, 0.0f);
         ss.str("");
-        ss << "COMBO: " << game.getComboCount() << "x";
+        ss << "COMBO: " << hud.combo << "x";
         renderText(12.0f, y, ss.str());
         y -= 0.5f;
         glColor3f(1.0f, 1.0f, 1.0f);
@@ -798,7 +931,7 @@ void drawStatsPanel()
 
         glColor3f(1.0f, 1.0f, 1.0f);
         ss.str("");
-        ss << trash_names[i] << ": " << game.getRecycledCount(static_cast<TrashType>(i));
+        ss << trash_names[i] << ": " << hud.recycled[i];
         renderText(12.5f, y, ss.str(), GLUT_BITMAP_8_BY_13);
         y -= 0.4f;
     }
@@ -808,16 +941,26 @@ void drawStatsPanel()
 
 void drawAchievementNotifications()
 {
-    // Implementação simplificada para evitar dependências
     glDisable(GL_TEXTURE_2D);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    renderText(18.0f, 8.0f, "Conquistas: OK", GLUT_BITMAP_8_BY_13);
+    std::stringstream ss;
+    if (achievement_notice_ticks > 0)
+    {
+        glColor3f(1.0f, 0.85f, 0.2f);
+        ss << "Conquista: " << achievement_notice;
+    }
+    else
+    {
+        glColor3f(1.0f, 1.0f, 1.0f);
+        ss << "Conquistas: " << hud.achievements << "/"
+           << AchievementManager::getInstance().getAllAchievements().size();
+    }
+    renderText(18.0f, 8.0f, ss.str(), GLUT_BITMAP_8_BY_13);
     glEnable(GL_TEXTURE_2D);
 }
 
 void drawComboEffects()
 {
-    if (game.getComboCount() > 1)
+    if (hud.combo > 1)
     {
         glDisable(GL_TEXTURE_2D);
 
@@ -831,15 +974,15 @@ void drawComboEffects()
         glLineWidth(5.0f);
         glBegin(GL_LINE_LOOP);
         glVertex2f(-0.5f, -0.5f);
-        glVertex2f(10.5f, -0.5f);
-        glVertex2f(10.5f, 20.5f);
-        glVertex2f(-0.5f, 20.5f);
+        glVertex2f(Game::Width + 0.5f, -0.5f);
+        glVertex2f(Game::Width + 0.5f, Game::Height + 0.5f);
+        glVertex2f(-0.5f, Game::Height + 0.5f);
         glEnd();
         glLineWidth(1.0f);
 
         // Texto de combo flutuante
         char combo_text[32];
-        sprintf(combo_text, "COMBO x%d!", game.getComboCount());
+        sprintf(combo_text, "COMBO x%d!", hud.combo);
 
         float text_y = 15.0f + 2.0f * sin(combo_glow * 0.5f);
         glColor4f(1.0f, 1.0f, 0.0f, glow_intensity);
@@ -849,9 +992,9 @@ void drawComboEffects()
     }
 }
 
-void drawRecyclingAnimation()
+void drawRecyclingAnimation(const RecycleAnimation &animation)
 {
-    TrashType type = game.getLineTrashType();
+    TrashType type = animation.type;
     float r, g, b;
 
     switch (type)
@@ -884,17 +1027,17 @@ void drawRecyclingAnimation()
     }
 
     // Lixeira animada maior
-    float scale = 1.5f + 0.2f * sin(game.getAnimationStep() * 0.8f);
+    float scale = 1.5f + 0.2f * sin(animation.step * 0.8f);
     drawRecycleBin(20.0f, 10.0f, r, g, b, scale, true);
 
     // Trilha de partículas do bloco até a lixeira
-    if (game.getAnimationStep() > 0 && game.getAnimationStep() <= 10)
+    if (animation.step > 0 && animation.step <= RECYCLE_ANIMATION_STEPS)
     {
-        float progress = (float)game.getAnimationStep() / 10.0f;
+        float progress = (float)animation.step / RECYCLE_ANIMATION_STEPS;
 
         // Bloco principal caindo
-        float start_x = game.getLineBeingCleared() >= 0 ? 5.0f : 5.0f;
-        float start_y = game.getLineBeingCleared();
+        float start_x = 5.0f;
+        float start_y = animation.row;
         float end_x = 19.5f;
         float end_y = 11.0f;
 
@@ -1070,6 +1213,25 @@ void options(unsigned char key, int x, int y)
                 glutPostRedisplay();
                 break;
 
+            case 't':
+            case 'T':
+                turbo_mode = !turbo_mode;
+                std::cout << "Modo turbo " << (turbo_mode ? "ligado" : "desligado") << std::endl;
+                glutPostRedisplay();
+                break;
+
+            case 'a':
+            case 'A':
+                // Desligado -> guloso -> feixe -> MCTS -> desligado
+                autoplay = static_cast<AutoplayMode>((autoplay + 1) % 4);
+                autoplay_counter = 0;
+                {
+                    const char *autoplay_names[] = {"desligado", "guloso", "feixe", "MCTS"};
+                    std::cout << "Jogador automático: " << autoplay_names[autoplay] << std::endl;
+                }
+                glutPostRedisplay();
+                break;
+
             case 'c':
             case 'C':
                 if (!game.getGameOver())
@@ -1082,14 +1244,7 @@ void options(unsigned char key, int x, int y)
             case ' ': // Barra de espaço para drop rápido
                 if (!game.getGameOver())
                 {
-                    while (!game.getGameOver() && !game.isLineClearing())
-                    {
-                        if (game.checkCollision(game.getCurrentX(), game.getCurrentY() - 1, game.getCurrentRotation()))
-                        {
-                            break;
-                        }
-                        game.moveDown();
-                    }
+                    game.hardDrop();
                     glutPostRedisplay();
                 }
                 break;
@@ -1136,44 +1291,217 @@ void options(unsigned char key, int x, int y)
     }
 }
 
-// Timer atualizado
-void timer(int id)
+// Copia do jogo os valores exibidos no painel
+void refreshHud()
 {
-    // Só executar lógica do jogo se estiver jogando
-    if (current_state == GAME_PLAYING)
+    hud.score = game.getScore();
+    hud.level = game.getLevel();
+    hud.lines = game.getLinesCleared();
+    hud.combo = game.getComboCount();
+    for (int i = 0; i < 5; i++)
     {
-        static auto last_time = std::chrono::steady_clock::now();
-        auto current_time = std::chrono::steady_clock::now();
-        auto delta_time = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - last_time);
+        hud.recycled[i] = game.getRecycledCount(static_cast<TrashType>(i));
+    }
+    hud.achievements = AchievementManager::getInstance().getUnlockedCount();
+}
 
-        game.update();
+void handleGameEvent(const GameEvent &event)
+{
+    switch (event.type)
+    {
+    case EVENT_GAME_RESET:
+        recycle_animations.clear();
+        refreshHud();
+        break;
 
-        if (game_initialized)
+    case EVENT_LINES_CLEARED:
+        // Linhas uniformes viram animação; as mistas só somem
+        for (int i = 0; i < event.lines; i++)
         {
-            if (game.getGameOver())
+            if (event.types[i] != NONE)
             {
-                game_initialized = false;
+                recycle_animations.push_back(
+                    RecycleAnimation{event.rows[i], static_cast<TrashType>(event.types[i]), 0, 0});
+            }
+        }
+        refreshHud();
+        break;
+
+    case EVENT_LEVEL_UP:
+        std::cout << "Nível " << event.value << " alcançado!" << std::endl;
+        refreshHud();
+        break;
+
+    case EVENT_COMBO_CHANGED:
+        refreshHud();
+        break;
+
+    case EVENT_GAME_OVER:
+        // Um fim de jogo ainda na fila não deve parar a partida seguinte
+        if (game.getGameOver())
+        {
+            if (autoplay != AUTOPLAY_OFF)
+            {
+                game.restart();
+                game_start_time = std::chrono::steady_clock::now();
             }
             else
             {
-                // Movimento automático baseado no nível
-                static int drop_counter = 0;
-                int drop_interval = (int)(30 * game.getDifficultyMultiplier());
+                game_initialized = false;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    AchievementManager &achievements = AchievementManager::getInstance();
+    achievements.handleEvent(event, game);
+    if (achievements.hasNewAchievement())
+    {
+        achievement_notice = achievements.getLatestAchievement().name;
+        achievement_notice_ticks = ACHIEVEMENT_NOTICE_TICKS;
+        achievements.clearNotification();
+        refreshHud();
+    }
+}
+
+// Um tick fixo da simulação: eventos, efeitos e gravidade
+void simulationTick()
+{
+    game.update();
+
+    GameEvent event;
+    while (game_events.pop(event))
+    {
+        handleGameEvent(event);
+    }
 
-                drop_counter++;
-                if (drop_counter >= drop_interval)
+    if (achievement_notice_ticks > 0)
+    {
+        achievement_notice_ticks--;
+    }
+
+    // Animações avançam no relógio da simulação; as terminadas saem da fila
+    for (RecycleAnimation &animation : recycle_animations)
+    {
+        if (++animation.ticks >= RECYCLE_STEP_TICKS)
+        {
+            animation.step++;
+            animation.ticks = 0;
+        }
+    }
+    recycle_animations.erase(std::remove_if(recycle_animations.begin(), recycle_animations.end(),
+                                            [](const RecycleAnimation &animation)
+                                            { return animation.step >= RECYCLE_ANIMATION_STEPS; }),
+                             recycle_animations.end());
+
+    // game_initialized cai com EVENT_GAME_OVER
+    if (game_initialized)
+    {
+        // Movimento automático baseado no nível
+        int drop_interval = std::max(1, (int)(GRAVITY_TICKS * game.getDifficultyMultiplier()));
+
+        if (autoplay != AUTOPLAY_OFF && game.hasActivePiece() && ++autoplay_counter >= AUTOPLAY_TICKS)
+        {
+            if (autoplay == AUTOPLAY_GREEDY)
+            {
+                autoplayer.play(game);
+            }
+            else if (autoplay == AUTOPLAY_BEAM)
+            {
+                if (!beam_planner)
                 {
-                    game.moveDown();
-                    drop_counter = 0;
+                    beam_planner.reset(new BeamPlanner());
                 }
+                int interval_us = drop_interval * 1000000 / SIM_TICKS_PER_SECOND;
+                MoveGenerator::apply(game, beam_planner->plan(game, BeamPlanner::budgetForGravity(interval_us)));
             }
+            else
+            {
+                if (!mcts_planner)
+                {
+                    mcts_planner.reset(new MctsPlanner());
+                }
+                int interval_us = drop_interval * 1000000 / SIM_TICKS_PER_SECOND;
+                MoveGenerator::apply(game, mcts_planner->plan(game, MctsPlanner::budgetForGravity(interval_us)));
+            }
+            autoplay_counter = 0;
+        }
+
+        gravity_counter++;
+        if (gravity_counter >= drop_interval)
+        {
+            game.moveDown();
+            gravity_counter = 0;
         }
+    }
+}
 
-        last_time = current_time;
+// Turbo: roda ticks sem esperar o relógio até a hora do próximo quadro
+void runTurboFrame()
+{
+    if (turbo_draw_every > 0)
+    {
+        for (int i = 0; i < turbo_draw_every; i++)
+        {
+            simulationTick();
+        }
+        return;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000 / TURBO_DISPLAY_FPS);
+    do
+    {
+        // O relógio só é consultado a cada lote de ticks
+        for (int i = 0; i < 64; i++)
+        {
+            simulationTick();
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+}
+
+// Timer da GLUT: mede o tempo real desde a chamada anterior e roda os ticks
+// que couberem nele; o atraso do próprio timer não altera a velocidade.
+// No turbo o timer é rearmado sem espera e cada chamada desenha um quadro.
+void timer(int id)
+{
+    static auto last_time = std::chrono::steady_clock::now();
+    auto current_time = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<FixedStepClock::Duration>(current_time - last_time);
+    last_time = current_time;
+
+    // Só executar lógica do jogo se estiver jogando; no menu e na pausa o
+    // tempo não se acumula
+    int next_delay = 16;
+    if (current_state == GAME_PLAYING)
+    {
+        if (turbo_mode)
+        {
+            runTurboFrame();
+            sim_clock.reset();
+            render_alpha = 0.0f;
+            next_delay = 0;
+        }
+        else
+        {
+            int ticks = sim_clock.advance(elapsed);
+            for (int i = 0; i < ticks; i++)
+            {
+                simulationTick();
+            }
+            render_alpha = (float)sim_clock.getAlpha();
+        }
+    }
+    else
+    {
+        sim_clock.reset();
+        render_alpha = 0.0f;
     }
 
     glutPostRedisplay();
-    glutTimerFunc(16, timer, id + 1);
+    glutTimerFunc(next_delay, timer, id + 1);
 }
 
 // Função para redimensionamento da janela
@@ -1188,15 +1516,57 @@ void reshape(int width, int height)
 
 int main(int argc, char **argv)
 {
-    srand(time(NULL));
-
     glutInit(&argc, argv);
+
+    // Opções próprias (a GLUT já removeu as dela)
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--turbo") == 0)
+        {
+            turbo_mode = true;
+        }
+        else if (strcmp(argv[i], "--turbo-draw-every") == 0 && i + 1 < argc)
+        {
+            turbo_mode = true;
+            turbo_draw_every = std::max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--autoplay") == 0)
+        {
+            autoplay = AUTOPLAY_GREEDY;
+        }
+        else if (strcmp(argv[i], "--autoplay-beam") == 0)
+        {
+            autoplay = AUTOPLAY_BEAM;
+        }
+        else if (strcmp(argv[i], "--autoplay-mcts") == 0)
+        {
+            autoplay = AUTOPLAY_MCTS;
+        }
+        else
+        {
+            std::cerr << "uso: Tetris [--turbo] [--turbo-draw-every N] [--autoplay | --autoplay-beam | --autoplay-mcts]" << std::endl;
+            return 2;
+        }
+    }
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_ALPHA);
     glutInitWindowPosition(100, 50);
     glutInitWindowSize(1000, 700);
     glutCreateWindow("EcoTetris - Reciclagem Sustentavel");
 
     init();
+    game.setEffectsEnabled(true);
+    game.setEventRing(&game_events);
+    AchievementManager::getInstance().init();
+    refreshHud();
+
+    // Modo demonstração: a partida começa sem passar pelo menu
+    if (autoplay != AUTOPLAY_OFF)
+    {
+        current_state = GAME_PLAYING;
+        game.restart();
+        game_start_time = std::chrono::steady_clock::now();
+        game_initialized = true;
+    }
 
     glutDisplayFunc(drawBoard);
     glutSpecialFunc(transform);
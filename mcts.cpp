@@ -0,0 +1,283 @@
+#include "mcts.hpp"
+#include <math.h>
+#include <algorithm>
+#include <climits>
+
+// Domínio das sementes de cada iteração, separado das chaves do Game
+static const uint64_t ZOBRIST_ITERATION = 5ULL << 40;
+
+// Fluxo do gerador dos rollouts aleatórios (o do jogo fica com a partida)
+static const uint64_t ROLLOUT_STREAM = 0x6d637473ULL;
+
+// Joga uma aresta guardada: false, sem travar nada, se a jogada não couber
+// na peça que está na mão (o nó não deveria ter sido reaproveitado)
+static bool applyStored(Game &game, Move move){
+    if (move.hold) game.holdPiece();
+    move.hold = false;
+    if (!game.hasActivePiece() || game.checkCollision(move.x, move.y, move.rotation)) return false;
+    MoveGenerator::apply(game, move);
+    return true;
+}
+
+MctsPlanner::MctsPlanner(int threads, const AutoWeights &weights) : weights(weights) {
+    if (threads != 1) pool.reset(new ThreadPool(threads));
+    for (int i = 0; i < getThreadCount(); i++) {
+        arenas.push_back(std::unique_ptr<Arena>(new Arena()));
+    }
+}
+
+Move MctsPlanner::plan(const Game &game, int budget_us){
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = budget_us > 0 ? start + std::chrono::microseconds(budget_us)
+                                               : Clock::time_point::max();
+    last_iterations = 0;
+    last_nodes = 0;
+    last_skipped = 0;
+
+    // Sem busca, a peça cai onde está
+    Move best = {(int8_t)game.getCurrentRotation(), (int8_t)game.getCurrentX(), (int8_t)game.getCurrentY(), false};
+    if (game.hasActivePiece()) best.y = (int8_t)game.landingRow();
+
+    EvalWeights eval_weights = toEvalWeights(weights, game.getRules());
+    for (size_t i = 0; i < arenas.size(); i++) {
+        arenas[i]->game.setRules(game.getRules());
+        arenas[i]->scratch.setRules(game.getRules());
+        arenas[i]->evaluator.setWeights(eval_weights);
+    }
+
+    nodes.clear();
+    edges.clear();
+    nodes.push_back(Node{-1, 0, 0, -1});
+    root_state = game.snapshot();
+    root_score = game.getScore();
+    value_low = 1e300;
+    value_high = -1e300;
+    started = 0;
+    skipped = 0;
+
+    // A raiz é expandida antes das threads: sempre há jogadas avaliadas
+    Arena &first = *arenas[0];
+    first.game.restore(root_state);
+    if (game.hasActivePiece()) first.generator.generate(first.game, first.moves, first.game.canHold());
+    else first.moves.clear();
+    if (!first.moves.empty()) {
+        evaluateMoves(first, root_state);
+        attach(0, first.moves, first.values);
+
+        long limit = budget_us > 0 ? LONG_MAX : iterations;
+        uint64_t root_hash = game.getHash();
+        if (pool) {
+            for (int t = 0; t < pool->getThreadCount(); t++) {
+                pool->submit([this, root_hash, limit, deadline](int worker) {
+                    run(*arenas[worker], root_hash, limit, deadline);
+                });
+            }
+            pool->wait();
+        }
+        else {
+            run(first, root_hash, limit, deadline);
+        }
+
+        // A mais visitada; empates pela média e depois pela ordem
+        const Node &root = nodes[0];
+        int chosen = root.first_edge;
+        for (int e = root.first_edge + 1; e < root.first_edge + root.edge_count; e++) {
+            const Edge &edge = edges[e];
+            const Edge &current = edges[chosen];
+            if (edge.visits > current.visits
+                || (edge.visits == current.visits
+                    && edge.value_sum / edge.visits > current.value_sum / current.visits)) {
+                chosen = e;
+            }
+        }
+        best = edges[chosen].move;
+        last_iterations = (int)started;
+        last_skipped = (int)skipped;
+    }
+
+    last_nodes = (int)nodes.size();
+    last_micros = (int)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    return best;
+}
+
+void MctsPlanner::run(Arena &arena, uint64_t root_hash, long limit, Clock::time_point deadline){
+    while (Clock::now() < deadline) {
+        long index;
+        {
+            std::lock_guard<std::mutex> lock(tree_mutex);
+            if (started >= limit) return;
+            index = started++;
+        }
+        iterate(arena, root_hash ^ zobristKey(ZOBRIST_ITERATION + (uint64_t)index));
+    }
+}
+
+void MctsPlanner::iterate(Arena &arena, uint64_t seed){
+    Game &game = arena.game;
+    game.restore(root_state);
+    game.seed(seed); // Depois da próxima peça, o futuro desta iteração
+    arena.rng.seed(seed, ROLLOUT_STREAM);
+    arena.path.clear();
+
+    // Seleção: desce pelas arestas de maior UCT até um nó ainda sem
+    // arestas, uma peça sorteada pela primeira vez ou o fim da partida
+    int leaf = -1;
+    {
+        std::lock_guard<std::mutex> lock(tree_mutex);
+        int node = 0;
+        while (nodes[node].edge_count > 0) {
+            int e = select(node);
+            if (!applyStored(game, edges[e].move)) {
+                // Desfaz a iteração em vez de travar uma peça inválida
+                for (size_t i = 0; i < arena.path.size(); i++) edges[arena.path[i]].virtual_loss--;
+                skipped++;
+                return;
+            }
+            edges[e].virtual_loss++;
+            arena.path.push_back(e);
+            if (game.getGameOver()) break;
+
+            // O resultado do acaso são as peças (atual com a posição de
+            // entrada, próxima e hold), não só a próxima: um hold com o
+            // espaço vazio também sorteia a peça atual
+            uint64_t key = game.getHash() ^ game.getBoardHash();
+            int child = edges[e].first_outcome;
+            while (child >= 0 && nodes[child].key != key) child = nodes[child].next_outcome;
+            if (child < 0) {
+                // Árvore cheia: a iteração vira só um rollout daqui
+                if ((int)nodes.size() >= MAX_NODES) break;
+                child = (int)nodes.size();
+                nodes.push_back(Node{-1, 0, key, edges[e].first_outcome});
+                edges[e].first_outcome = child;
+            }
+            node = child;
+        }
+        if (!game.getGameOver() && nodes[node].edge_count == 0) leaf = node;
+    }
+
+    // Expansão e rollout, fora da trava
+    double value = GAME_OVER_VALUE;
+    if (!game.getGameOver() && game.hasActivePiece()) {
+        for (int step = 0; step < rollout_depth && !game.getGameOver() && game.hasActivePiece(); step++) {
+            arena.generator.generate(game, arena.moves, game.canHold());
+            if (arena.moves.empty()) break;
+
+            GameState from = game.snapshot();
+            int choice = 0;
+            if (step == 0 || rollout_policy == ROLLOUT_GREEDY) {
+                choice = evaluateMoves(arena, from);
+                if (step == 0 && leaf >= 0) attach(leaf, arena.moves, arena.values);
+            }
+            if (rollout_policy == ROLLOUT_RANDOM) {
+                choice = (int)arena.rng.below((uint32_t)arena.moves.size());
+            }
+            game.restore(from);
+            MoveGenerator::apply(game, arena.moves[choice]);
+        }
+        value = leafValue(game);
+    }
+
+    std::lock_guard<std::mutex> lock(tree_mutex);
+    if (value > GAME_OVER_VALUE) {
+        if (value < value_low) value_low = value;
+        if (value > value_high) value_high = value;
+    }
+    for (size_t i = 0; i < arena.path.size(); i++) {
+        Edge &edge = edges[arena.path[i]];
+        edge.virtual_loss--;
+        edge.visits++;
+        edge.value_sum += value;
+    }
+}
+
+// UCT sobre valores normalizados. As perdas virtuais contam como visitas
+// de valor 0, o pior possível.
+int MctsPlanner::select(int node){
+    const Node &n = nodes[node];
+    int total = 0;
+    for (int e = n.first_edge; e < n.first_edge + n.edge_count; e++) {
+        total += edges[e].visits + edges[e].virtual_loss;
+    }
+    double log_total = log((double)total);
+
+    int best = n.first_edge;
+    double best_score = -1e300;
+    for (int e = n.first_edge; e < n.first_edge + n.edge_count; e++) {
+        const Edge &edge = edges[e];
+        int count = edge.visits + edge.virtual_loss;
+        double q = normalize(edge.value_sum / edge.visits) * edge.visits / count;
+        double score = q + exploration * sqrt(log_total / count);
+        if (score > best_score) {
+            best_score = score;
+            best = e;
+        }
+    }
+    return best;
+}
+
+// Liga as jogadas avaliadas ao nó; false se outra thread já o expandiu ou
+// se não houver espaço
+bool MctsPlanner::attach(int node, const std::vector<Move> &moves, const std::vector<double> &values){
+    std::lock_guard<std::mutex> lock(tree_mutex);
+    if (nodes[node].edge_count > 0 || edges.size() + moves.size() > (size_t)MAX_EDGES) return false;
+
+    nodes[node].first_edge = (int)edges.size();
+    nodes[node].edge_count = (int)moves.size();
+    for (size_t i = 0; i < moves.size(); i++) {
+        edges.push_back(Edge{moves[i], 1, 0, values[i], -1});
+        if (values[i] > GAME_OVER_VALUE) {
+            if (values[i] < value_low) value_low = values[i];
+            if (values[i] > value_high) value_high = values[i];
+        }
+    }
+    return true;
+}
+
+// Valor de cada jogada de arena.moves a partir de from, em lotes do
+// avaliador (mesma conta de leafValue); devolve o índice da melhor
+int MctsPlanner::evaluateMoves(Arena &arena, const GameState &from){
+    size_t count = arena.moves.size();
+    arena.values.resize(count);
+    int best = 0;
+    for (size_t first = 0; first < count; first += BoardEvaluator::Lanes) {
+        int lanes = (int)std::min(count - first, (size_t)BoardEvaluator::Lanes);
+        for (int k = 0; k < lanes; k++) {
+            arena.scratch.restore(from);
+            MoveGenerator::apply(arena.scratch, arena.moves[first + k]);
+            arena.evaluator.load(k, arena.scratch.getBoardView());
+            arena.points[k] = arena.scratch.getScore() - root_score;
+            arena.game_over[k] = arena.scratch.getGameOver();
+        }
+        arena.evaluator.run(lanes, arena.lane_values);
+
+        for (int k = 0; k < lanes; k++) {
+            double value = arena.game_over[k] ? GAME_OVER_VALUE
+                                              : arena.lane_values[k] + weights.score * arena.points[k];
+            arena.values[first + k] = value;
+            if (value > arena.values[best]) best = (int)(first + k);
+        }
+    }
+    return best;
+}
+
+double MctsPlanner::leafValue(const Game &game) const {
+    if (game.getGameOver()) return GAME_OVER_VALUE;
+    return evaluateBoard(weights, game, game.getScore() - root_score);
+}
+
+double MctsPlanner::normalize(double value) const {
+    if (value_high <= value_low) return 0.5;
+    double t = (value - value_low) / (value_high - value_low);
+    return t < 0 ? 0 : (t > 1 ? 1 : t);
+}
+
+Placement MctsPlanner::choose(const Game &game){
+    Move move = plan(game);
+    Placement placement = {move.rotation, move.x, move.hold};
+    return placement;
+}
+
+void MctsPlanner::play(Game &game){
+    if (!game.hasActivePiece()) return;
+    MoveGenerator::apply(game, plan(game));
+}
@@ -0,0 +1,157 @@
+#ifndef MCTS_HPP
+#define MCTS_HPP
+
+#include <stdint.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "autoplayer.hpp"
+#include "evaluator.hpp"
+#include "game.hpp"
+#include "movegen.hpp"
+#include "policy.hpp"
+#include "thread_pool.hpp"
+
+// Busca em árvore Monte Carlo (UCT) sobre as posições finais da peça, com
+// hold. A raiz é o estado do Game; cada aresta é uma jogada e leva a um nó
+// de acaso, cujos filhos são as próximas peças sorteadas. A peça seguinte à
+// atual está à vista e vale como está; daí em diante cada iteração ressemeia
+// o gerador da cópia, então generateNextPiece sorteia um futuro diferente e
+// a árvore aprende a média sobre as peças em vez de um futuro conhecido.
+//
+// Ao expandir um nó, todas as jogadas são avaliadas num lote do
+// BoardEvaluator e esse valor é a primeira amostra de cada aresta: com
+// poucas iterações a busca já começa pelas melhores. Daí segue um rollout
+// curto (guloso pelo mesmo avaliador, ou aleatório) e o valor final volta
+// pelo caminho.
+//
+// As iterações rodam em paralelo nas threads do ThreadPool sobre a mesma
+// árvore. Seleção e retropropagação passam por uma trava única; expansão e
+// rollout, a parte cara, rodam fora dela em Games sem tela de cada thread.
+// A perda virtual nas arestas em uso afasta as outras threads do mesmo
+// caminho.
+class MctsPlanner : public Policy{
+    public:
+        static const int DEFAULT_ITERATIONS = 256;
+        static const int DEFAULT_ROLLOUT_DEPTH = 2;
+        static const int MAX_NODES = 1 << 16;
+        static const int MAX_EDGES = 1 << 20;
+
+        enum RolloutPolicy {ROLLOUT_GREEDY, ROLLOUT_RANDOM};
+
+        // threads <= 0 usa todos os núcleos; com 1 a busca roda na thread
+        // de quem chama
+        explicit MctsPlanner(int threads = 0, const AutoWeights &weights = AutoWeights());
+
+        int getThreadCount() const { return pool ? pool->getThreadCount() : 1; }
+
+        // Iterações por jogada sem orçamento de tempo
+        void setIterations(int count) { iterations = count < 1 ? 1 : count; }
+        int getIterations() const { return iterations; }
+
+        // Jogadas de cada rollout, contando a que sai do nó expandido
+        void setRolloutDepth(int new_depth) { rollout_depth = new_depth < 1 ? 1 : new_depth; }
+        int getRolloutDepth() const { return rollout_depth; }
+
+        void setRolloutPolicy(RolloutPolicy policy) { rollout_policy = policy; }
+        RolloutPolicy getRolloutPolicy() const { return rollout_policy; }
+
+        // Constante de exploração do UCT, sobre valores normalizados em [0, 1]
+        void setExploration(double c) { exploration = c; }
+        double getExploration() const { return exploration; }
+
+        const AutoWeights &getWeights() const { return weights; }
+        void setWeights(const AutoWeights &new_weights) { weights = new_weights; }
+
+        // Jogada mais visitada da raiz. budget_us 0 = getIterations()
+        // iterações; com uma thread o resultado só depende do estado.
+        Move plan(const Game &game, int budget_us = 0);
+
+        // Mesmo orçamento por queda do BeamPlanner
+        static int budgetForGravity(int interval_us) { return interval_us / 4; }
+
+        // Como Policy: um plan sem orçamento por peça
+        Placement choose(const Game &game);
+        void play(Game &game);
+
+        // Estatísticas do último plan
+        int getLastIterations() const { return last_iterations; }
+        int getLastNodes() const { return last_nodes; }
+        int getLastMicros() const { return last_micros; }
+
+        // Iterações descartadas por uma aresta guardada que não coube na
+        // peça (deve ser sempre 0)
+        int getLastSkipped() const { return last_skipped; }
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        // Valor de uma partida perdida; os demais ficam bem acima
+        static constexpr double GAME_OVER_VALUE = -1000.0;
+
+        // Nó de decisão: as arestas são contíguas em edges. key é o hash
+        // das peças sem o tabuleiro (atual, próxima e hold) sorteadas a
+        // partir do nó de acaso da aresta pai; o tabuleiro já é dado pelo
+        // caminho. next_outcome é o irmão seguinte.
+        struct Node {
+            int first_edge;
+            int edge_count;
+            uint64_t key;
+            int next_outcome;
+        };
+
+        struct Edge {
+            Move move;
+            int visits;        // A avaliação da expansão conta como a primeira
+            int virtual_loss;  // Threads passando por ela agora
+            double value_sum;
+            int first_outcome; // Primeiro filho do nó de acaso (-1 se nenhum)
+        };
+
+        struct alignas(64) Arena {
+            Game game, scratch;
+            MoveGenerator generator;
+            std::vector<Move> moves;
+            std::vector<double> values;
+            BoardEvaluator evaluator;
+            int points[BoardEvaluator::Lanes];
+            bool game_over[BoardEvaluator::Lanes];
+            double lane_values[BoardEvaluator::Lanes];
+            std::vector<int> path; // Arestas da iteração atual
+            Rng rng;
+        };
+
+        void run(Arena &arena, uint64_t root_hash, long limit, Clock::time_point deadline);
+        void iterate(Arena &arena, uint64_t seed);
+        int select(int node);
+        bool attach(int node, const std::vector<Move> &moves, const std::vector<double> &values);
+        int evaluateMoves(Arena &arena, const GameState &from);
+        double leafValue(const Game &game) const;
+        double normalize(double value) const;
+
+        AutoWeights weights;
+        int iterations = DEFAULT_ITERATIONS;
+        int rollout_depth = DEFAULT_ROLLOUT_DEPTH;
+        RolloutPolicy rollout_policy = ROLLOUT_GREEDY;
+        double exploration = 0.7;
+        int last_iterations = 0;
+        int last_nodes = 0;
+        int last_micros = 0;
+        int last_skipped = 0;
+
+        std::unique_ptr<ThreadPool> pool;
+        std::vector<std::unique_ptr<Arena>> arenas;
+
+        // Árvore da jogada atual e dados da raiz, sob tree_mutex
+        std::mutex tree_mutex;
+        std::vector<Node> nodes;
+        std::vector<Edge> edges;
+        GameState root_state;
+        int root_score = 0;
+        double value_low = 0, value_high = 0; // Faixa dos valores vistos (sem game over)
+        long started = 0;                     // Iterações iniciadas
+        long skipped = 0;                     // Iterações desfeitas por applyStored
+};
+
+#endif // MCTS_HPP
@@ -0,0 +1,200 @@
+#include "movegen.hpp"
+
+// Rotação de menor índice com as mesmas células (a menos de translação) e o
+// deslocamento da âncora até ela: a peça na rotação r com âncora (x, y)
+// ocupa as mesmas células que na rotação canon com âncora (x + dx, y + dy)
+struct CanonicalRotation {
+    int8_t canon, dx, dy;
+};
+
+struct CanonicalTable {
+    CanonicalRotation entries[7][4];
+};
+
+constexpr bool sameCells(const PieceMask &a, const PieceMask &b){
+    if (a.width != b.width || a.height != b.height) return false;
+    for (int i = 0; i < 4; i++) {
+        if (a.rows[i] != b.rows[i]) return false;
+    }
+    return true;
+}
+
+constexpr CanonicalTable makeCanonicalTable(){
+    CanonicalTable t = {};
+    for (int s = 0; s < 7; s++) {
+        for (int r = 0; r < 4; r++) {
+            int c = 0;
+            while (!sameCells(pieceMask(s, c), pieceMask(s, r))) c++;
+            t.entries[s][r].canon = c;
+            t.entries[s][r].dx = pieceMask(s, r).min_dx - pieceMask(s, c).min_dx;
+            t.entries[s][r].dy = pieceMask(s, r).min_dy - pieceMask(s, c).min_dy;
+        }
+    }
+    return t;
+}
+
+static constexpr CanonicalTable canonical_table = makeCanonicalTable();
+
+static_assert(canonical_table.entries[6][3].canon == 0, "o quadrado tem uma única forma");
+static_assert(canonical_table.entries[0][2].canon == 0 && canonical_table.entries[0][3].canon == 1,
+              "a peça I tem duas formas");
+
+static inline uint64_t shiftColumns(uint64_t mask, int dx){
+    return dx >= 0 ? mask << dx : mask >> -dx;
+}
+
+// Âncoras da linha y em que a peça cabe (bit x = coluna x): parte da faixa
+// de colunas válidas e, para cada célula da peça, apaga as âncoras que a
+// colocariam sobre um bloco, deslocando a linha do tabuleiro inteira
+template<class RowMask>
+static uint64_t fitMask(const RowMask *rows, int width, int height, const PieceMask &piece, int y){
+    int bottom = y + piece.min_dy;
+    if (bottom < 0 || y + piece.max_dy >= height) return 0;
+
+    uint64_t fit = lowBits(width - piece.max_dx) & ~lowBits(-piece.min_dx);
+    for (int r = 0; r < piece.height; r++) {
+        uint64_t row = rows[bottom + r];
+        uint64_t cells = piece.rows[r];
+        while (cells) {
+            int dx = piece.min_dx + lowestBit(cells);
+            fit &= ~shiftColumns(row, -dx);
+            cells &= cells - 1;
+        }
+    }
+    return fit;
+}
+
+// Expande as âncoras alcançadas para os lados enquanto a peça couber
+static inline uint64_t spreadRow(uint64_t reach, uint64_t fit){
+    for (;;) {
+        uint64_t next = (reach | (reach << 1) | (reach >> 1)) & fit;
+        if (next == reach) return reach;
+        reach = next;
+    }
+}
+
+template<int W, int H>
+void BasicMoveGenerator<W, H>::addLandings(const GameType &game, bool hold, std::vector<Move> &moves) const {
+    if (!game.hasActivePiece() || game.getGameOver()) return;
+
+    const int shape = game.getCurrentShape();
+    const typename GameType::BoardViewType view = game.getBoardView();
+    const auto *rows = view.getRows();
+    const PieceMask *masks[4];
+    for (int r = 0; r < 4; r++) {
+        masks[r] = &pieceMask(shape, r);
+    }
+
+    uint64_t fit_here[4], fit_below[4], reach[4] = {0, 0, 0, 0};
+    uint64_t landed[4][H] = {};
+
+    int y = game.getCurrentY();
+    for (int r = 0; r < 4; r++) {
+        fit_here[r] = fitMask(rows, W, H, *masks[r], y);
+    }
+    reach[game.getCurrentRotation()] = 1ULL << game.getCurrentX();
+
+    for (; y >= 0; y--) {
+        // Fecho da linha: deslocamentos e rotações (r -> r - 1, como em
+        // Game::rotate) até nenhuma âncora nova aparecer
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int r = 3; r >= 0; r--) {
+                if (!reach[r]) continue;
+                reach[r] = spreadRow(reach[r], fit_here[r]);
+                int next = (r + 3) & 3;
+                uint64_t rotated = reach[r] & fit_here[next] & ~reach[next];
+                if (rotated) {
+                    reach[next] |= rotated;
+                    changed = true;
+                }
+            }
+        }
+
+        // O que não cabe uma linha abaixo trava aqui; o resto desce
+        uint64_t any = 0;
+        for (int r = 0; r < 4; r++) {
+            fit_below[r] = y > 0 ? fitMask(rows, W, H, *masks[r], y - 1) : 0;
+            uint64_t stops = reach[r] & ~fit_below[r];
+            if (stops) {
+                const CanonicalRotation &c = canonical_table.entries[shape][r];
+                landed[c.canon][y + c.dy] |= shiftColumns(stops, c.dx);
+            }
+            reach[r] &= fit_below[r];
+            fit_here[r] = fit_below[r];
+            any |= reach[r];
+        }
+        if (!any) break;
+    }
+
+    for (int r = 0; r < 4; r++) {
+        for (int row = 0; row < H; row++) {
+            uint64_t columns = landed[r][row];
+            while (columns) {
+                Move move = {(int8_t)r, (int8_t)lowestBit(columns), (int8_t)row, hold};
+                moves.push_back(move);
+                columns &= columns - 1;
+            }
+        }
+    }
+}
+
+template<int W, int H>
+int BasicMoveGenerator<W, H>::generate(const GameType &game, std::vector<Move> &moves, bool include_hold){
+    moves.clear();
+    addLandings(game, false, moves);
+
+    if (include_hold && game.canHold() && game.hasActivePiece()) {
+        hold_scratch.restore(game.snapshot());
+        hold_scratch.holdPiece();
+        addLandings(hold_scratch, true, moves);
+    }
+    return (int)moves.size();
+}
+
+template<int W, int H>
+void BasicMoveGenerator<W, H>::apply(GameType &game, const Move &move){
+    if (move.hold) game.holdPiece();
+    if (!game.hasActivePiece()) return;
+
+    TrashType types[4];
+    for (int i = 0; i < 4; i++) {
+        types[i] = game.getCurrentTrashTypes()[i];
+    }
+    game.setCurrentPiece(game.getCurrentShape(), move.rotation, move.x, move.y, types);
+    game.hardDrop();
+}
+
+template<int W, int H>
+uint64_t BasicMoveGenerator<W, H>::perft(const GameType &game, int depth, bool include_hold){
+    if (depth <= 0) return 1;
+
+    while ((int)children.size() < depth) {
+        children.push_back(std::unique_ptr<GameType>(new GameType()));
+        level_moves.push_back(std::vector<Move>());
+    }
+    return perftNode(game, depth, include_hold);
+}
+
+// Na última profundidade as folhas são só contadas, sem jogar cada uma
+template<int W, int H>
+uint64_t BasicMoveGenerator<W, H>::perftNode(const GameType &game, int depth, bool include_hold){
+    std::vector<Move> &moves = level_moves[depth - 1];
+    generate(game, moves, include_hold);
+    if (depth == 1) return moves.size();
+
+    GameType &child = *children[depth - 1];
+    State start = game.snapshot();
+    uint64_t leaves = 0;
+    for (const Move &move : moves) {
+        child.restore(start);
+        apply(child, move);
+        leaves += perftNode(child, depth - 1, include_hold);
+    }
+    return leaves;
+}
+
+template class BasicMoveGenerator<10, 20>;
+template class BasicMoveGenerator<16, 40>;
+template class BasicMoveGenerator<32, 64>;
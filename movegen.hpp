@@ -0,0 +1,56 @@
+#ifndef MOVEGEN_HPP
+#define MOVEGEN_HPP
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "game.hpp"
+
+// Posição final de uma peça: rotação e âncora em que ela trava,
+// opcionalmente depois de usar o hold
+struct Move {
+    int8_t rotation;
+    int8_t x, y;
+    bool hold;
+};
+
+// Gerador de jogadas: enumera toda posição final distinta que a peça atual
+// alcança com as entradas do jogo (mover, girar, descer), inclusive encaixes
+// por baixo de saliências. A busca é um flood fill em bits sobre os estados
+// (x, y, rotação): para cada rotação e linha, uma máscara de bits com as
+// colunas em que a âncora cabe e outra com as já alcançadas, expandidas por
+// deslocamentos até estabilizar, de cima para baixo. Posições de rotações
+// diferentes que ocupam as mesmas células contam uma vez só.
+template<int W, int H>
+class BasicMoveGenerator{
+    public:
+        typedef BasicGame<W, H> GameType;
+        typedef typename GameType::State State;
+
+        // Preenche moves com as jogadas da peça atual e, se include_hold,
+        // também as da peça que entra pelo hold. Devolve quantas são.
+        int generate(const GameType &game, std::vector<Move> &moves, bool include_hold = false);
+
+        // Usa o hold se a jogada pedir, coloca a peça na posição e a trava
+        static void apply(GameType &game, const Move &move);
+
+        // Folhas da árvore de jogadas até a profundidade depth. A sequência
+        // de peças é a da semente do jogo.
+        uint64_t perft(const GameType &game, int depth, bool include_hold = false);
+
+    private:
+        void addLandings(const GameType &game, bool hold, std::vector<Move> &moves) const;
+        uint64_t perftNode(const GameType &game, int depth, bool include_hold);
+
+        GameType hold_scratch;
+        std::vector<std::unique_ptr<GameType>> children;
+        std::vector<std::vector<Move>> level_moves;
+};
+
+typedef BasicMoveGenerator<10, 20> MoveGenerator;
+
+extern template class BasicMoveGenerator<10, 20>;
+extern template class BasicMoveGenerator<16, 40>;
+extern template class BasicMoveGenerator<32, 64>;
+
+#endif // MOVEGEN_HPP
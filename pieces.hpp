@@ -0,0 +1,188 @@
+#ifndef PIECES_HPP
+#define PIECES_HPP
+
+#include <stdint.h>
+
+// Definição de todas as peças (tetrominos) e suas rotações.
+// Cada rotação lista os deslocamentos (dx, dy) das três células em volta da
+// célula âncora (0, 0), que sempre faz parte da peça.
+inline constexpr int shapes[7][4][6] =
+{
+    {
+        {-2, 0, -1, 0, 1, 0}, //I shape
+        {0, -2, 0, -1, 0, 1},
+        {2, 0, 1, 0, -1, 0},
+        {0, 2, 0, 1, 0, -1}
+    },
+    {
+        {-1, -1, 0, -1, 1, 0}, //S shape
+        {1, -1, 1, 0, 0, 1},
+        {1, 1, 0, 1, -1, 0},
+        {-1, 1, -1, 0, 0, -1}
+    },
+    {
+        {-1, 1, 0, 1, 1, 0}, //reverse S shape
+        {-1, -1, -1, 0, 0, 1},
+        {1, -1, 0, -1, -1, 0},
+        {1, 1, 1, 0, 0, -1}
+    },
+    {
+        {-1, -1, -1, 0, 1, 0}, //L shape
+        {1, -1, 0, -1, 0, 1},
+        {1, 1, 1, 0, -1, 0},
+        {-1, 1, 0, 1, 0, -1}
+    },
+    {
+        {-1, 1, -1, 0, 1, 0}, //reverse L shape
+        {-1, -1, 0, -1, 0, 1},
+        {1, -1, 1, 0, -1, 0},
+        {1, 1, 0, 1, 0, -1}
+    },
+    {
+        {-1, 0, 0, -1, 1, 0}, //T shape
+        {0, -1, 1, 0, 0, 1},
+        {1, 0, 0, 1, -1, 0},
+        {0, 1, -1, 0, 0, -1}
+    },
+    {
+        {0, -1, -1, -1, -1, 0}, //square shape
+        {0, -1, -1, -1, -1, 0},
+        {0, -1, -1, -1, -1, 0},
+        {0, -1, -1, -1, -1, 0}
+    }
+};
+
+// Máscaras de uma peça em uma rotação, geradas a partir de shapes.
+// rows[r] é a linha min_dy + r da peça, com a coluna min_dx no bit 0.
+// bottom[c] é a linha (relativa a min_dy) da célula mais baixa da coluna
+// min_dx + c, usada para calcular a queda sem descer linha a linha.
+struct PieceMask {
+    uint16_t rows[4];
+    int8_t min_dx, max_dx;
+    int8_t min_dy, max_dy;
+    int8_t width, height;
+    int8_t bottom[4];
+};
+
+// Faixa de âncoras (x, y) em que a peça cabe inteira num tabuleiro
+struct SpawnExtent {
+    int8_t min_x, max_x;
+    int8_t min_y, max_y;
+};
+
+constexpr int pieceCellX(int shape, int rotation, int cell){
+    return cell == 0 ? 0 : shapes[shape][rotation][(cell - 1) * 2];
+}
+
+constexpr int pieceCellY(int shape, int rotation, int cell){
+    return cell == 0 ? 0 : shapes[shape][rotation][(cell - 1) * 2 + 1];
+}
+
+constexpr PieceMask makePieceMask(int shape, int rotation){
+    PieceMask m = {{0, 0, 0, 0}, 0, 0, 0, 0, 0, 0, {4, 4, 4, 4}};
+    for(int c = 0; c < 4; c++){
+        int dx = pieceCellX(shape, rotation, c);
+        int dy = pieceCellY(shape, rotation, c);
+        if(dx < m.min_dx) m.min_dx = dx;
+        if(dx > m.max_dx) m.max_dx = dx;
+        if(dy < m.min_dy) m.min_dy = dy;
+        if(dy > m.max_dy) m.max_dy = dy;
+    }
+    for(int c = 0; c < 4; c++){
+        int dx = pieceCellX(shape, rotation, c);
+        int dy = pieceCellY(shape, rotation, c);
+        m.rows[dy - m.min_dy] |= (uint16_t)(1u << (dx - m.min_dx));
+        if(dy - m.min_dy < m.bottom[dx - m.min_dx]) m.bottom[dx - m.min_dx] = dy - m.min_dy;
+    }
+    m.width = m.max_dx - m.min_dx + 1;
+    m.height = m.max_dy - m.min_dy + 1;
+    return m;
+}
+
+struct PieceTable {
+    PieceMask masks[7][4];
+};
+
+constexpr PieceTable makePieceTable(){
+    PieceTable t = {};
+    for(int s = 0; s < 7; s++){
+        for(int r = 0; r < 4; r++){
+            t.masks[s][r] = makePieceMask(s, r);
+        }
+    }
+    return t;
+}
+
+inline constexpr PieceTable piece_table = makePieceTable();
+
+constexpr const PieceMask &pieceMask(int shape, int rotation){
+    return piece_table.masks[shape][rotation];
+}
+
+constexpr SpawnExtent spawnExtent(int shape, int rotation, int board_width, int board_height){
+    SpawnExtent e = {0, 0, 0, 0};
+    const PieceMask &m = pieceMask(shape, rotation);
+    e.min_x = -m.min_dx;
+    e.max_x = board_width - 1 - m.max_dx;
+    e.min_y = -m.min_dy;
+    e.max_y = board_height - 1 - m.max_dy;
+    return e;
+}
+
+// Verificações de consistência das tabelas em tempo de compilação
+constexpr int countBits(unsigned v){
+    return v == 0 ? 0 : (int)(v & 1) + countBits(v >> 1);
+}
+
+constexpr bool pieceTableIsConsistent(){
+    for(int s = 0; s < 7; s++){
+        for(int r = 0; r < 4; r++){
+            const PieceMask &m = pieceMask(s, r);
+            int cells = 0;
+            for(int i = 0; i < 4; i++){
+                if(i >= m.height && m.rows[i] != 0) return false;
+                if(m.rows[i] >> m.width) return false;
+                cells += countBits(m.rows[i]);
+            }
+            // Quatro células distintas, a âncora incluída, sem linha vazia
+            if(cells != 4) return false;
+            if(!((m.rows[-m.min_dy] >> -m.min_dx) & 1)) return false;
+            for(int i = 0; i < m.height; i++){
+                if(m.rows[i] == 0) return false;
+            }
+            // Cada coluna ocupada tem a célula mais baixa marcada
+            for(int c = 0; c < 4; c++){
+                if((c < m.width) != (m.bottom[c] < m.height)) return false;
+                if(c < m.width && !((m.rows[m.bottom[c]] >> c) & 1)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(pieceTableIsConsistent(), "tabela de peças inconsistente");
+static_assert(pieceMask(0, 0).width == 4 && pieceMask(0, 0).height == 1, "peça I deitada deve ser 4x1");
+static_assert(pieceMask(0, 1).width == 1 && pieceMask(0, 1).height == 4, "peça I em pé deve ser 1x4");
+static_assert(pieceMask(6, 0).rows[0] == 3 && pieceMask(6, 0).rows[1] == 3, "quadrado deve ser 2x2");
+
+// Área de spawn: x de largura/2 - 3 a largura/2 + 1 e y = altura - 3
+// (no tabuleiro 10x20, x de 2 a 6 e y = 17). O hold usa x = largura/2.
+constexpr int spawnMinX(int board_width) { return board_width / 2 - 3; }
+constexpr int spawnMaxX(int board_width) { return board_width / 2 + 1; }
+constexpr int spawnY(int board_height) { return board_height - 3; }
+
+// Toda rotação precisa caber em toda a área de spawn (o hold está dentro dela)
+constexpr bool spawnPositionsFit(int board_width, int board_height){
+    for(int s = 0; s < 7; s++){
+        for(int r = 0; r < 4; r++){
+            SpawnExtent e = spawnExtent(s, r, board_width, board_height);
+            if(e.min_x > spawnMinX(board_width) || e.max_x < spawnMaxX(board_width)) return false;
+            if(e.min_y > spawnY(board_height) || e.max_y < spawnY(board_height)) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(spawnPositionsFit(10, 20), "peças não cabem na área de spawn");
+
+#endif // PIECES_HPP
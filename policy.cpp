@@ -0,0 +1,123 @@
+#include "policy.hpp"
+#include "autoplayer.hpp"
+#include <sstream>
+#include <string>
+
+// Gira e desloca a peça atual até a jogada; false se não alcançou
+static bool reachPlacement(Game &game, const Placement &placement){
+    if (placement.hold) game.holdPiece();
+    if (!game.hasActivePiece()) return false;
+
+    for (int i = 0; i < 3 && game.getCurrentRotation() != placement.rotation; i++) {
+        game.rotate();
+    }
+
+    int direction = placement.x < game.getCurrentX() ? -1 : 1;
+    while (game.getCurrentX() != placement.x) {
+        int before = game.getCurrentX();
+        game.translate(direction);
+        if (game.getCurrentX() == before) break; // Bloqueada
+    }
+
+    return game.getCurrentRotation() == placement.rotation && game.getCurrentX() == placement.x;
+}
+
+void applyPlacement(Game &game, const Placement &placement){
+    reachPlacement(game, placement);
+    game.hardDrop();
+}
+
+void Policy::play(Game &game){
+    applyPlacement(game, choose(game));
+}
+
+// Política aleatória
+static const uint64_t POLICY_STREAM = 0x5eed0003;
+
+RandomPolicy::RandomPolicy(uint64_t seed_value){
+    reset(seed_value);
+}
+
+void RandomPolicy::reset(uint64_t seed_value){
+    rng.seed(seed_value, POLICY_STREAM);
+}
+
+Placement RandomPolicy::choose(const Game &game){
+    Placement placement;
+    placement.rotation = rng.below(4);
+    placement.x = rng.below(Game::Width);
+    placement.hold = false;
+    return placement;
+}
+
+// Política com roteiro
+ScriptedPolicy::ScriptedPolicy(const std::vector<Placement> &moves) : moves(moves) {}
+
+Placement ScriptedPolicy::choose(const Game &game){
+    if (moves.empty()) {
+        Placement stay = {game.getCurrentRotation(), game.getCurrentX(), false};
+        return stay;
+    }
+    Placement placement = moves[next_move];
+    next_move = (next_move + 1) % moves.size();
+    return placement;
+}
+
+bool ScriptedPolicy::parse(std::istream &in, std::vector<Placement> &moves){
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        Placement placement = {0, 0, false};
+        std::string hold;
+        if (!(fields >> placement.rotation >> placement.x)) return false;
+        if (placement.rotation < 0 || placement.rotation > 3) return false;
+        if (placement.x < 0 || placement.x >= Game::Width) return false;
+        if (fields >> hold) placement.hold = (hold == "h");
+        moves.push_back(placement);
+    }
+    return true;
+}
+
+// Robô guloso
+Placement BotPolicy::choose(const Game &game){
+    GameState start = game.snapshot();
+    scratch.setRules(game.getRules());
+    Placement best = {game.getCurrentRotation(), game.getCurrentX(), false};
+    double best_value = -1e300;
+
+    int hold_options = game.canHold() ? 2 : 1;
+    for (int h = 0; h < hold_options; h++) {
+        for (int r = 0; r < 4; r++) {
+            for (int x = 0; x < Game::Width; x++) {
+                Placement placement = {r, x, h == 1};
+                scratch.restore(start);
+                if (!reachPlacement(scratch, placement)) continue;
+
+                scratch.hardDrop();
+
+                double value = evaluate(game, scratch);
+                if (value > best_value) {
+                    best_value = value;
+                    best = placement;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// A heurística clássica do AutoPlayer (altura, buracos, irregularidade e
+// pontuação ganha), sem poços nem linhas de um só tipo
+static AutoWeights botWeights(){
+    AutoWeights weights;
+    weights.wells = 0;
+    weights.uniform = 0;
+    return weights;
+}
+
+double BotPolicy::evaluate(const Game &before, const Game &after) const {
+    static const AutoWeights weights = botWeights();
+    return evaluateBoard(weights, after, after.getScore() - before.getScore());
+}
@@ -0,0 +1,74 @@
+#ifndef POLICY_HPP
+#define POLICY_HPP
+
+#include <vector>
+#include <istream>
+#include "game.hpp"
+
+// Jogada de uma peça: rotação e coluna da âncora antes do hard drop,
+// opcionalmente usando o hold antes de posicionar
+struct Placement {
+    int rotation;
+    int x;
+    bool hold;
+};
+
+// Política que decide onde cada peça cai. Usada pelo simulador sem tela
+// para jogar partidas inteiras sem entrada do teclado.
+class Policy{
+    public:
+        virtual ~Policy() {}
+        virtual Placement choose(const Game &game) = 0;
+
+        // Joga a peça atual; o padrão é aplicar a escolha de choose
+        virtual void play(Game &game);
+
+        // Volta ao estado inicial antes de uma nova partida com essa semente
+        virtual void reset(uint64_t seed_value) {}
+};
+
+// Leva a peça atual até a jogada (hold, rotação, translação) e faz o hard
+// drop. Se a rotação ou a coluna não forem alcançáveis, a peça cai na mais
+// próxima que conseguiu alcançar.
+void applyPlacement(Game &game, const Placement &placement);
+
+// Rotação e coluna sorteadas a cada peça
+class RandomPolicy : public Policy{
+    public:
+        explicit RandomPolicy(uint64_t seed_value);
+        Placement choose(const Game &game);
+        void reset(uint64_t seed_value);
+
+    private:
+        Rng rng;
+};
+
+// Repete em ciclo uma lista fixa de jogadas
+class ScriptedPolicy : public Policy{
+    public:
+        explicit ScriptedPolicy(const std::vector<Placement> &moves);
+        Placement choose(const Game &game);
+        void reset(uint64_t seed_value) { next_move = 0; }
+
+        // Uma jogada por linha: "rotação x [h]"; linhas vazias e com # são ignoradas
+        static bool parse(std::istream &in, std::vector<Placement> &moves);
+
+    private:
+        std::vector<Placement> moves;
+        size_t next_move = 0;
+};
+
+// Robô guloso: testa toda rotação e coluna num jogo de rascunho e fica com
+// a que deixa o tabuleiro mais baixo, plano e sem buracos (os pesos de
+// AutoWeights para essas características, via evaluateBoard)
+class BotPolicy : public Policy{
+    public:
+        Placement choose(const Game &game);
+
+    private:
+        double evaluate(const Game &before, const Game &after) const;
+
+        Game scratch;
+};
+
+#endif // POLICY_HPP
@@ -0,0 +1,62 @@
+#include "render.hpp"
+#include <iostream>
+#define GL_CLAMP_TO_EDGE 0x812F
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+// Inicialização das variáveis estáticas
+GLuint TextureManager::texture_ids[5] = {0, 0, 0, 0, 0};
+bool TextureManager::textures_loaded = false;
+
+void TextureManager::loadTextures() {
+    if (textures_loaded) return;
+    
+    stbi_set_flip_vertically_on_load(true);
+    glGenTextures(5, texture_ids);
+    
+    const char* texture_files[5] = {
+        "textures/paper.png",
+        "textures/plastic.png",
+        "textures/metal.png",
+        "textures/glass.png",
+        "textures/organic.png"
+    };
+    
+    for (int i = 0; i < 5; i++) {
+        int width, height, channels;
+        unsigned char* data = stbi_load(texture_files[i], &width, &height, &channels, 0);
+        
+        if (data) {
+            glBindTexture(GL_TEXTURE_2D, texture_ids[i]);
+            
+            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+            
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            
+            stbi_image_free(data);
+            std::cout << "Textura carregada: " << texture_files[i] << std::endl;
+        } else {
+            std::cout << "Erro ao carregar textura: " << texture_files[i] << std::endl;
+        }
+    }
+    
+    textures_loaded = true;
+    std::cout << "Texturas carregadas com sucesso!" << std::endl;
+}
+
+void TextureManager::bindTexture(TrashType type) {
+    if (!textures_loaded) {
+        loadTextures();
+    }
+    
+    if (type >= 0 && type < 5) {
+        glBindTexture(GL_TEXTURE_2D, texture_ids[type]);
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef RENDER_HPP
+#define RENDER_HPP
+
+#include <GL/glut.h>
+#include "board.hpp"
+
+// Texturas dos tipos de lixo, separadas do motor do jogo para que
+// game.hpp não dependa de OpenGL
+class TextureManager{
+    public:
+        static void loadTextures();
+        static void bindTexture(TrashType type);
+
+    private:
+        // IDs das texturas OpenGL
+        static GLuint texture_ids[5];
+        static bool textures_loaded;
+};
+
+#endif // RENDER_HPP
@@ -0,0 +1,55 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <stdint.h>
+
+// Gerador PCG32 (O'Neill): 16 bytes de estado, rápido e com fluxos
+// independentes selecionados pelo incremento. Cada Game tem os seus,
+// então partidas com a mesma semente são idênticas bit a bit e instâncias
+// em threads diferentes não compartilham estado.
+class Rng{
+    public:
+        Rng() { seed(0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL); }
+        Rng(uint64_t seed_value, uint64_t stream) { seed(seed_value, stream); }
+
+        void seed(uint64_t seed_value, uint64_t stream){
+            state = 0;
+            inc = (stream << 1) | 1u;
+            next();
+            state += seed_value;
+            next();
+        }
+
+        uint32_t next(){
+            uint64_t old = state;
+            state = old * 6364136223846793005ULL + inc;
+            uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+            uint32_t rot = (uint32_t)(old >> 59);
+            return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+        }
+
+        // Inteiro uniforme em [0, bound), sem viés (método de Lemire)
+        uint32_t below(uint32_t bound){
+            uint64_t m = (uint64_t)next() * bound;
+            uint32_t low = (uint32_t)m;
+            if(low < bound){
+                uint32_t threshold = (0u - bound) % bound;
+                while(low < threshold){
+                    m = (uint64_t)next() * bound;
+                    low = (uint32_t)m;
+                }
+            }
+            return (uint32_t)(m >> 32);
+        }
+
+        // Real uniforme em [0, 1)
+        float uniform(){
+            return (next() >> 8) * (1.0f / 16777216.0f);
+        }
+
+    private:
+        uint64_t state;
+        uint64_t inc;
+};
+
+#endif // RNG_HPP
@@ -0,0 +1,64 @@
+#include "rules.hpp"
+
+// Endereço do campo de cada regra; os inteiros são arredondados ao escrever
+struct RuleField {
+    const char *name;
+    int *(*integer)(RulesConfig &rules);
+    float *(*real)(RulesConfig &rules);
+};
+
+static const RuleField rule_fields[] = {
+    {"base_paper", [](RulesConfig &r) { return &r.base_scores[PAPER]; }, nullptr},
+    {"base_plastic", [](RulesConfig &r) { return &r.base_scores[PLASTIC]; }, nullptr},
+    {"base_metal", [](RulesConfig &r) { return &r.base_scores[METAL]; }, nullptr},
+    {"base_glass", [](RulesConfig &r) { return &r.base_scores[GLASS]; }, nullptr},
+    {"base_organic", [](RulesConfig &r) { return &r.base_scores[ORGANIC]; }, nullptr},
+    {"level_step", nullptr, [](RulesConfig &r) { return &r.level_step; }},
+    {"combo_step", nullptr, [](RulesConfig &r) { return &r.combo_step; }},
+    {"uniform_bonus", nullptr, [](RulesConfig &r) { return &r.uniform_bonus; }},
+    {"combo_bonus", nullptr, [](RulesConfig &r) { return &r.combo_bonus; }},
+    {"lines_per_level", [](RulesConfig &r) { return &r.lines_per_level; }, nullptr},
+    {"difficulty_step", nullptr, [](RulesConfig &r) { return &r.difficulty_step; }},
+    {"min_difficulty", nullptr, [](RulesConfig &r) { return &r.min_difficulty; }},
+};
+
+static const int rule_count = sizeof(rule_fields) / sizeof(rule_fields[0]);
+
+static const RuleField *findRule(const std::string &name){
+    for (int i = 0; i < rule_count; i++) {
+        if (name == rule_fields[i].name) return &rule_fields[i];
+    }
+    return nullptr;
+}
+
+int getRuleCount(){
+    return rule_count;
+}
+
+const char *getRuleName(int index){
+    return index >= 0 && index < rule_count ? rule_fields[index].name : nullptr;
+}
+
+bool setRule(RulesConfig &rules, const std::string &name, double value){
+    const RuleField *field = findRule(name);
+    if (!field) return false;
+
+    if (field->integer) {
+        int rounded = (int)(value < 0 ? value - 0.5 : value + 0.5);
+        // Pelo menos uma linha por nível, senão o nível seria indefinido
+        if (name == "lines_per_level" && rounded < 1) return false;
+        *field->integer(rules) = rounded;
+    }
+    else {
+        *field->real(rules) = (float)value;
+    }
+    return true;
+}
+
+double getRule(const RulesConfig &rules, const std::string &name){
+    const RuleField *field = findRule(name);
+    if (!field) return 0.0;
+
+    RulesConfig copy = rules;
+    return field->integer ? *field->integer(copy) : *field->real(copy);
+}
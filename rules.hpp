@@ -0,0 +1,61 @@
+#ifndef RULES_HPP
+#define RULES_HPP
+
+#include <string>
+#include "board.hpp"
+
+// Constantes de pontuação e dificuldade, ajustáveis em tempo de execução.
+// Os valores padrão são as regras originais do jogo.
+struct RulesConfig {
+    // Pontuação base de uma linha uniforme de cada tipo de lixo
+    int base_scores[5] = {100, 150, 200, 175, 125};
+
+    // Multiplicadores: 1 + (nível - 1) * level_step e 1 + combo * combo_step
+    float level_step = 0.1f;
+    float combo_step = 0.2f;
+
+    // Bônus por linha uniforme e bônus adicional para combos
+    float uniform_bonus = 1.5f;
+    float combo_bonus = 1.5f;
+
+    // Linhas recicladas por nível
+    int lines_per_level = 10;
+
+    // Intervalo da gravidade: 1 - (nível - 1) * difficulty_step, no mínimo
+    // min_difficulty (só afeta o jogo com tela)
+    float difficulty_step = 0.05f;
+    float min_difficulty = 0.1f;
+};
+
+// Pontos por linhas uniformes recicladas de um tipo
+inline int recyclePoints(const RulesConfig &rules, TrashType type, int lines, int level, int combo_count, bool is_combo) {
+    int base_points = rules.base_scores[type] * lines;
+
+    // Multiplicador de nível
+    float level_multiplier = 1.0f + (level - 1) * rules.level_step;
+
+    // Multiplicador de combo
+    float combo_multiplier = 1.0f + combo_count * rules.combo_step;
+
+    int points = (int)(base_points * level_multiplier * combo_multiplier * rules.uniform_bonus);
+
+    if (is_combo) {
+        points = (int)(points * rules.combo_bonus); // Bônus adicional para combos
+    }
+    return points;
+}
+
+// Nível alcançado com esse total de linhas
+inline int levelForLines(const RulesConfig &rules, int lines_cleared) {
+    return lines_cleared / rules.lines_per_level + 1;
+}
+
+// Regras por nome ("base_paper", "level_step", ...), para o simulador e a
+// varredura de parâmetros. Os nomes são os campos de RulesConfig, com
+// base_scores separado por tipo.
+int getRuleCount();
+const char *getRuleName(int index);
+bool setRule(RulesConfig &rules, const std::string &name, double value);
+double getRule(const RulesConfig &rules, const std::string &name);
+
+#endif // RULES_HPP
@@ -0,0 +1,243 @@
+#include "game.hpp"
+#include "autoplayer.hpp"
+#include "beam.hpp"
+#include "mcts.hpp"
+#include "policy.hpp"
+#include "simfarm.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Simulador sem tela: joga N partidas com uma política, cada uma até o game
+// over ou até o limite de peças, e grava o resultado de cada partida em CSV
+// ou JSON. No fim informa no stderr a vazão agregada em peças por segundo.
+
+struct SimOptions
+{
+    int games = 100;
+    int threads = 0; // 0 = todos os núcleos
+    uint64_t seed = 1;
+    int max_pieces = 10000; // 0 = sem limite
+    std::string policy = "bot";
+    std::string script;
+    std::string format = "csv";
+    std::string output;
+    RulesConfig rules;
+};
+
+static const char *recycled_names[5] = {"paper", "plastic", "metal", "glass", "organic"};
+
+static void usage()
+{
+    fprintf(stderr,
+            "uso: ecotetris-sim [opções]\n"
+            "  --games N         número de partidas (padrão 100)\n"
+            "  --threads T       threads da simulação, 0 = todos os núcleos (padrão 0)\n"
+            "  --seed S          semente da primeira partida; a partida i usa S + i (padrão 1)\n"
+            "  --max-pieces P    limite de peças por partida, 0 = sem limite (padrão 10000)\n"
+            "  --policy NOME     random, scripted, bot, auto, beam ou mcts (padrão bot)\n"
+            "  --script ARQUIVO  jogadas da política scripted, uma por linha: rotação x [h]\n"
+            "  --format FMT      csv ou json (padrão csv)\n"
+            "  --output ARQUIVO  destino dos resultados (padrão stdout)\n"
+            "  --rule NOME=V     muda uma regra de pontuação (ex.: base_metal=250, lines_per_level=8)\n");
+}
+
+static bool parseOptions(int argc, char **argv, SimOptions &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+            return false;
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "opção sem valor: %s\n", arg);
+            return false;
+        }
+        const char *value = argv[++i];
+
+        if (strcmp(arg, "--games") == 0)
+            options.games = atoi(value);
+        else if (strcmp(arg, "--threads") == 0)
+            options.threads = atoi(value);
+        else if (strcmp(arg, "--seed") == 0)
+            options.seed = strtoull(value, NULL, 10);
+        else if (strcmp(arg, "--max-pieces") == 0)
+            options.max_pieces = atoi(value);
+        else if (strcmp(arg, "--policy") == 0)
+            options.policy = value;
+        else if (strcmp(arg, "--script") == 0)
+            options.script = value;
+        else if (strcmp(arg, "--format") == 0)
+            options.format = value;
+        else if (strcmp(arg, "--output") == 0)
+            options.output = value;
+        else if (strcmp(arg, "--rule") == 0)
+        {
+            const char *eq = strchr(value, '=');
+            if (!eq || !setRule(options.rules, std::string(value, eq - value), atof(eq + 1)))
+            {
+                fprintf(stderr, "regra inválida: %s\n", value);
+                return false;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "opção desconhecida: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options.games <= 0 || options.max_pieces < 0)
+    {
+        fprintf(stderr, "--games deve ser positivo e --max-pieces não negativo\n");
+        return false;
+    }
+    if (options.format != "csv" && options.format != "json")
+    {
+        fprintf(stderr, "formato desconhecido: %s\n", options.format.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Fábrica de políticas, uma por thread da simulação; o roteiro da política
+// scripted é lido uma vez só
+static bool makePolicyFactory(const SimOptions &options, SimFarm::PolicyFactory &factory)
+{
+    if (options.policy == "random")
+    {
+        factory = []() { return std::unique_ptr<Policy>(new RandomPolicy(0)); };
+        return true;
+    }
+    if (options.policy == "bot")
+    {
+        factory = []() { return std::unique_ptr<Policy>(new BotPolicy()); };
+        return true;
+    }
+    if (options.policy == "auto")
+    {
+        // Sem orçamento de tempo: o resultado de cada semente não depende
+        // da carga da máquina
+        factory = []() { return std::unique_ptr<Policy>(new AutoPlayer(AutoWeights(), 0)); };
+        return true;
+    }
+    if (options.policy == "beam")
+    {
+        // As partidas já ocupam todos os núcleos: cada planejador usa uma
+        // thread só
+        factory = []() { return std::unique_ptr<Policy>(new BeamPlanner(1)); };
+        return true;
+    }
+    if (options.policy == "mcts")
+    {
+        // Uma thread e número fixo de iterações: reprodutível por semente
+        factory = []() { return std::unique_ptr<Policy>(new MctsPlanner(1)); };
+        return true;
+    }
+    if (options.policy == "scripted")
+    {
+        std::ifstream in(options.script.c_str());
+        std::vector<Placement> moves;
+        if (!in || !ScriptedPolicy::parse(in, moves) || moves.empty())
+        {
+            fprintf(stderr, "roteiro inválido: '%s'\n", options.script.c_str());
+            return false;
+        }
+        factory = [moves]() { return std::unique_ptr<Policy>(new ScriptedPolicy(moves)); };
+        return true;
+    }
+    fprintf(stderr, "política desconhecida: %s\n", options.policy.c_str());
+    return false;
+}
+
+static void writeCsv(FILE *out, const std::vector<GameResult> &results)
+{
+    fprintf(out, "seed,score,level,lines_cleared");
+    for (int i = 0; i < 5; i++)
+    {
+        fprintf(out, ",recycled_%s", recycled_names[i]);
+    }
+    fprintf(out, ",pieces_placed,wall_ms\n");
+
+    for (const GameResult &r : results)
+    {
+        fprintf(out, "%llu,%d,%d,%d", (unsigned long long)r.seed, r.score, r.level, r.lines_cleared);
+        for (int i = 0; i < 5; i++)
+        {
+            fprintf(out, ",%d", r.recycled_count[i]);
+        }
+        fprintf(out, ",%d,%.3f\n", r.pieces_placed, r.wall_ms);
+    }
+}
+
+static void writeJson(FILE *out, const std::vector<GameResult> &results)
+{
+    fprintf(out, "[\n");
+    for (size_t g = 0; g < results.size(); g++)
+    {
+        const GameResult &r = results[g];
+        fprintf(out, "  {\"seed\": %llu, \"score\": %d, \"level\": %d, \"lines_cleared\": %d, \"recycled_count\": {",
+                (unsigned long long)r.seed, r.score, r.level, r.lines_cleared);
+        for (int i = 0; i < 5; i++)
+        {
+            fprintf(out, "%s\"%s\": %d", i ? ", " : "", recycled_names[i], r.recycled_count[i]);
+        }
+        fprintf(out, "}, \"pieces_placed\": %d, \"wall_ms\": %.3f}%s\n",
+                r.pieces_placed, r.wall_ms, g + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "]\n");
+}
+
+int main(int argc, char **argv)
+{
+    SimOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        usage();
+        return 2;
+    }
+
+    SimFarm::PolicyFactory factory;
+    if (!makePolicyFactory(options, factory))
+        return 2;
+    SimFarm farm(options.threads, factory, options.max_pieces);
+    farm.setRules(options.rules);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GameResult> results = farm.run(options.seed, options.games);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long total_pieces = 0;
+    for (const GameResult &r : results)
+    {
+        total_pieces += r.pieces_placed;
+    }
+
+    FILE *out = stdout;
+    if (!options.output.empty())
+    {
+        out = fopen(options.output.c_str(), "w");
+        if (!out)
+        {
+            fprintf(stderr, "não foi possível abrir %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+    if (options.format == "json")
+        writeJson(out, results);
+    else
+        writeCsv(out, results);
+    if (out != stdout)
+        fclose(out);
+
+    fprintf(stderr, "%d partidas, política %s, %d threads: %lld peças em %.3f s (%.0f peças/s)\n",
+            options.games, options.policy.c_str(), farm.getThreadCount(), total_pieces, seconds,
+            seconds > 0 ? total_pieces / seconds : 0.0);
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "simfarm.hpp"
+#include <chrono>
+
+SimFarm::SimFarm(int threads, PolicyFactory make_policy, int max_pieces)
+    : max_pieces(max_pieces), pool(threads) {
+    for (int i = 0; i < pool.getThreadCount(); i++) {
+        std::unique_ptr<Arena> arena(new Arena());
+        arena->policy = make_policy();
+        arenas.push_back(std::move(arena));
+    }
+}
+
+std::vector<GameResult> SimFarm::run(uint64_t first_seed, int games){
+    std::vector<GameResult> results(games);
+
+    for (int g = 0; g < games; g++) {
+        pool.submit([this, &results, first_seed, g](int worker) {
+            Arena &arena = *arenas[worker];
+            arena.game.setRules(rules);
+            results[g] = playGame(arena.game, *arena.policy, first_seed + g, max_pieces);
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+GameResult SimFarm::playGame(Game &game, Policy &policy, uint64_t seed, int max_pieces){
+    auto start = std::chrono::steady_clock::now();
+
+    game.seed(seed);
+    game.restart();
+    policy.reset(seed);
+    while (!game.getGameOver() && (max_pieces == 0 || game.getPiecesPlaced() < max_pieces)) {
+        policy.play(game);
+    }
+
+    GameResult result;
+    result.seed = seed;
+    result.score = game.getScore();
+    result.level = game.getLevel();
+    result.lines_cleared = game.getLinesCleared();
+    for (int i = 0; i < 5; i++) {
+        result.recycled_count[i] = game.getRecycledCount(static_cast<TrashType>(i));
+    }
+    result.pieces_placed = game.getPiecesPlaced();
+    result.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
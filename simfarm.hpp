@@ -0,0 +1,59 @@
+#ifndef SIMFARM_HPP
+#define SIMFARM_HPP
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "game.hpp"
+#include "policy.hpp"
+#include "thread_pool.hpp"
+
+// Resultado de uma partida simulada
+struct GameResult {
+    uint64_t seed;
+    int score;
+    int level;
+    int lines_cleared;
+    int recycled_count[5];
+    int pieces_placed;
+    double wall_ms;
+};
+
+// Fazenda de simulação: espalha partidas independentes pelos núcleos com
+// o ThreadPool. Cada thread tem uma arena própria (um Game e uma Policy
+// reaproveitados de partida em partida), então nada é compartilhado entre
+// threads. Cada partida depende só da sua semente e o resultado vai para o
+// índice dela, logo a saída é a mesma com qualquer número de threads.
+class SimFarm{
+    public:
+        typedef std::function<std::unique_ptr<Policy>()> PolicyFactory;
+
+        // threads <= 0 usa todos os núcleos; max_pieces 0 = sem limite
+        SimFarm(int threads, PolicyFactory make_policy, int max_pieces);
+
+        int getThreadCount() const { return pool.getThreadCount(); }
+
+        // Regras usadas pelas próximas partidas
+        void setRules(const RulesConfig &new_rules) { rules = new_rules; }
+        const RulesConfig &getRules() const { return rules; }
+
+        // Joga as partidas com sementes first_seed, first_seed + 1, ...
+        std::vector<GameResult> run(uint64_t first_seed, int games);
+
+        // Uma partida do início ao fim com o jogo e a política dados
+        static GameResult playGame(Game &game, Policy &policy, uint64_t seed, int max_pieces);
+
+    private:
+        // Alinhada à linha de cache para threads vizinhas não disputarem a mesma
+        struct alignas(64) Arena {
+            Game game;
+            std::unique_ptr<Policy> policy;
+        };
+
+        std::vector<std::unique_ptr<Arena>> arenas;
+        RulesConfig rules;
+        int max_pieces;
+        ThreadPool pool;
+};
+
+#endif // SIMFARM_HPP
@@ -0,0 +1,324 @@
+#include "autoplayer.hpp"
+#include "game.hpp"
+#include "policy.hpp"
+#include "rules.hpp"
+#include "simfarm.hpp"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Varredura de regras: avalia uma grade ou uma amostra aleatória de
+// configurações de RulesConfig. Cada configuração joga as mesmas partidas
+// (mesmas sementes) em todos os núcleos e vira uma linha de CSV com o resumo
+// da distribuição de pontuação. Como as sementes são comuns, a diferença
+// entre duas linhas vem só das regras.
+
+static const uint64_t SAMPLE_STREAM = 0x5eed0018;
+
+// Regra varrida: valores da grade ou faixa da amostra
+struct SweepParam
+{
+    std::string name;
+    std::vector<double> values;
+    double min_value = 0.0;
+    double max_value = 0.0;
+    bool is_range = false;
+};
+
+struct SweepOptions
+{
+    std::vector<SweepParam> params;
+    int samples = 0; // 0 = grade completa
+    int games = 1000;
+    int threads = 0;
+    uint64_t seed = 1;
+    int max_pieces = 1000;
+    std::string policy = "bot";
+    std::string output;
+};
+
+static void usage()
+{
+    fprintf(stderr,
+            "uso: ecotetris-sweep [opções]\n"
+            "  --grid NOME=v1,v2,...  valores de uma regra; as grades se combinam (produto)\n"
+            "  --range NOME=min:max   faixa de uma regra, sorteada em cada amostra\n"
+            "  --samples K            sorteia K configurações em vez da grade completa\n"
+            "  --games N              partidas por configuração (padrão 1000)\n"
+            "  --threads T            threads, 0 = todos os núcleos (padrão 0)\n"
+            "  --seed S               semente da primeira partida e do sorteio (padrão 1)\n"
+            "  --max-pieces P         limite de peças por partida, 0 = sem limite (padrão 1000)\n"
+            "  --policy NOME          random, bot ou auto (padrão bot)\n"
+            "  --output ARQUIVO       destino do CSV (padrão stdout)\n"
+            "regras:");
+    for (int i = 0; i < getRuleCount(); i++)
+    {
+        fprintf(stderr, " %s", getRuleName(i));
+    }
+    fprintf(stderr, "\n(sem tela não há gravidade: difficulty_step e min_difficulty não mudam o resultado)\n");
+}
+
+static bool parseParam(const char *arg, bool is_range, SweepParam &param)
+{
+    const char *eq = strchr(arg, '=');
+    if (!eq)
+        return false;
+    param.name.assign(arg, eq - arg);
+    param.is_range = is_range;
+
+    RulesConfig probe;
+    if (!setRule(probe, param.name, getRule(probe, param.name)))
+    {
+        fprintf(stderr, "regra desconhecida: %s\n", param.name.c_str());
+        return false;
+    }
+
+    char *end = NULL;
+    if (is_range)
+    {
+        param.min_value = strtod(eq + 1, &end);
+        if (*end != ':')
+            return false;
+        param.max_value = strtod(end + 1, &end);
+        return *end == '\0' && param.min_value <= param.max_value;
+    }
+
+    const char *p = eq + 1;
+    while (*p)
+    {
+        param.values.push_back(strtod(p, &end));
+        if (end == p || (*end != ',' && *end != '\0'))
+            return false;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return !param.values.empty();
+}
+
+static bool parseOptions(int argc, char **argv, SweepOptions &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+            return false;
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "opção sem valor: %s\n", arg);
+            return false;
+        }
+        const char *value = argv[++i];
+
+        if (strcmp(arg, "--grid") == 0 || strcmp(arg, "--range") == 0)
+        {
+            SweepParam param;
+            if (!parseParam(value, strcmp(arg, "--range") == 0, param))
+            {
+                fprintf(stderr, "parâmetro inválido: %s %s\n", arg, value);
+                return false;
+            }
+            options.params.push_back(param);
+        }
+        else if (strcmp(arg, "--samples") == 0)
+            options.samples = atoi(value);
+        else if (strcmp(arg, "--games") == 0)
+            options.games = atoi(value);
+        else if (strcmp(arg, "--threads") == 0)
+            options.threads = atoi(value);
+        else if (strcmp(arg, "--seed") == 0)
+            options.seed = strtoull(value, NULL, 10);
+        else if (strcmp(arg, "--max-pieces") == 0)
+            options.max_pieces = atoi(value);
+        else if (strcmp(arg, "--policy") == 0)
+            options.policy = value;
+        else if (strcmp(arg, "--output") == 0)
+            options.output = value;
+        else
+        {
+            fprintf(stderr, "opção desconhecida: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options.params.empty() || options.games <= 0 || options.max_pieces < 0 || options.samples < 0)
+    {
+        fprintf(stderr, "informe ao menos uma --grid ou --range, --games positivo e --max-pieces não negativo\n");
+        return false;
+    }
+    if (options.samples == 0)
+    {
+        for (const SweepParam &param : options.params)
+        {
+            if (param.is_range)
+            {
+                fprintf(stderr, "--range %s exige --samples\n", param.name.c_str());
+                return false;
+            }
+        }
+    }
+    if (options.policy != "random" && options.policy != "bot" && options.policy != "auto")
+    {
+        fprintf(stderr, "política desconhecida: %s\n", options.policy.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Valores das regras varridas em cada configuração, na ordem de params
+static std::vector<std::vector<double>> buildConfigs(const SweepOptions &options)
+{
+    std::vector<std::vector<double>> configs;
+
+    if (options.samples > 0)
+    {
+        Rng rng(options.seed, SAMPLE_STREAM);
+        for (int s = 0; s < options.samples; s++)
+        {
+            std::vector<double> config;
+            for (const SweepParam &param : options.params)
+            {
+                if (param.is_range)
+                    config.push_back(param.min_value + (param.max_value - param.min_value) * rng.uniform());
+                else
+                    config.push_back(param.values[rng.below(param.values.size())]);
+            }
+            configs.push_back(config);
+        }
+        return configs;
+    }
+
+    // Produto cartesiano, com a última regra variando mais rápido
+    std::vector<size_t> index(options.params.size(), 0);
+    for (;;)
+    {
+        std::vector<double> config;
+        for (size_t p = 0; p < options.params.size(); p++)
+        {
+            config.push_back(options.params[p].values[index[p]]);
+        }
+        configs.push_back(config);
+
+        size_t p = options.params.size();
+        while (p > 0)
+        {
+            p--;
+            if (++index[p] < options.params[p].values.size())
+                break;
+            index[p] = 0;
+            if (p == 0)
+                return configs;
+        }
+    }
+}
+
+// Percentil pelo posto mais próximo numa lista ordenada
+static int percentile(const std::vector<int> &sorted, double fraction)
+{
+    size_t rank = (size_t)ceil(fraction * sorted.size());
+    if (rank > 0)
+        rank--;
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+static void writeSummary(FILE *out, int config_index, const std::vector<double> &values,
+                         const std::vector<GameResult> &results)
+{
+    std::vector<int> scores;
+    double sum = 0, lines = 0, levels = 0, pieces = 0;
+    for (const GameResult &r : results)
+    {
+        scores.push_back(r.score);
+        sum += r.score;
+        lines += r.lines_cleared;
+        levels += r.level;
+        pieces += r.pieces_placed;
+    }
+    std::sort(scores.begin(), scores.end());
+
+    double n = (double)results.size();
+    double mean = sum / n;
+    double variance = 0;
+    for (int score : scores)
+    {
+        variance += (score - mean) * (score - mean);
+    }
+    double stddev = results.size() > 1 ? sqrt(variance / (n - 1)) : 0.0;
+
+    fprintf(out, "%d", config_index);
+    for (double value : values)
+    {
+        fprintf(out, ",%g", value);
+    }
+    fprintf(out, ",%zu,%.2f,%.2f,%d,%d,%d,%d,%d,%d,%d,%.2f,%.2f,%.1f\n", results.size(), mean, stddev,
+            scores.front(), percentile(scores, 0.10), percentile(scores, 0.25), percentile(scores, 0.50),
+            percentile(scores, 0.75), percentile(scores, 0.90), scores.back(), lines / n, levels / n,
+            pieces / n);
+}
+
+int main(int argc, char **argv)
+{
+    SweepOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        usage();
+        return 2;
+    }
+
+    SimFarm::PolicyFactory factory;
+    if (options.policy == "random")
+        factory = []() { return std::unique_ptr<Policy>(new RandomPolicy(0)); };
+    else if (options.policy == "bot")
+        factory = []() { return std::unique_ptr<Policy>(new BotPolicy()); };
+    else
+        factory = []() { return std::unique_ptr<Policy>(new AutoPlayer(AutoWeights(), 0)); };
+    SimFarm farm(options.threads, factory, options.max_pieces);
+
+    FILE *out = stdout;
+    if (!options.output.empty())
+    {
+        out = fopen(options.output.c_str(), "w");
+        if (!out)
+        {
+            fprintf(stderr, "não foi possível abrir %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+
+    fprintf(out, "config");
+    for (const SweepParam &param : options.params)
+    {
+        fprintf(out, ",%s", param.name.c_str());
+    }
+    fprintf(out, ",games,score_mean,score_std,score_min,score_p10,score_p25,score_p50,score_p75,score_p90,"
+                 "score_max,lines_mean,level_mean,pieces_mean\n");
+
+    std::vector<std::vector<double>> configs = buildConfigs(options);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t c = 0; c < configs.size(); c++)
+    {
+        RulesConfig rules;
+        for (size_t p = 0; p < options.params.size(); p++)
+        {
+            if (!setRule(rules, options.params[p].name, configs[c][p]))
+            {
+                fprintf(stderr, "valor inválido para %s: %g\n", options.params[p].name.c_str(), configs[c][p]);
+                return 2;
+            }
+        }
+        farm.setRules(rules);
+        writeSummary(out, (int)c, configs[c], farm.run(options.seed, options.games));
+        fflush(out);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (out != stdout)
+        fclose(out);
+
+    fprintf(stderr, "%zu configurações x %d partidas, política %s, %d threads: %.3f s\n", configs.size(),
+            options.games, options.policy.c_str(), farm.getThreadCount(), seconds);
+    return 0;
+}
@@ -0,0 +1,130 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads com roubo de tarefas. Cada thread tem a própria fila:
+// tira tarefas do fim da sua e, quando ela esvazia, rouba do início da fila
+// de outra thread. As tarefas recebem o índice da thread que as executa,
+// para que cada uma use os próprios dados (arenas) sem sincronização.
+class ThreadPool{
+    public:
+        typedef std::function<void(int)> Task;
+
+        // threads <= 0 usa todos os núcleos da máquina
+        explicit ThreadPool(int threads = 0){
+            if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+            if (threads <= 0) threads = 1;
+
+            for (int i = 0; i < threads; i++) {
+                queues.push_back(std::unique_ptr<Queue>(new Queue()));
+            }
+            for (int i = 0; i < threads; i++) {
+                workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+            }
+        }
+
+        ~ThreadPool(){
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                stopping = true;
+            }
+            work_available.notify_all();
+            for (std::thread &worker : workers) {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        int getThreadCount() const { return (int)workers.size(); }
+
+        // Distribui as tarefas entre as filas em rodízio
+        void submit(Task task){
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                pending++;
+                queued++;
+            }
+            Queue &queue = *queues[next_queue];
+            next_queue = (next_queue + 1) % queues.size();
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(std::move(task));
+            }
+            work_available.notify_one();
+        }
+
+        // Bloqueia até todas as tarefas enviadas terminarem
+        void wait(){
+            std::unique_lock<std::mutex> lock(state_mutex);
+            all_done.wait(lock, [this]{ return pending == 0; });
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        bool popLocal(int index, Task &task){
+            Queue &queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) return false;
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+
+        bool steal(int thief, Task &task){
+            int count = (int)queues.size();
+            for (int i = 1; i < count; i++) {
+                Queue &queue = *queues[(thief + i) % count];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) continue;
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+            return false;
+        }
+
+        void workerLoop(int index){
+            while (true) {
+                Task task;
+                if (popLocal(index, task) || steal(index, task)) {
+                    queued--;
+                    task(index);
+
+                    std::lock_guard<std::mutex> lock(state_mutex);
+                    if (--pending == 0) all_done.notify_all();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(state_mutex);
+                work_available.wait(lock, [this]{ return stopping || queued.load() > 0; });
+                if (stopping && queued.load() == 0) return;
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+        size_t next_queue = 0;
+
+        std::mutex state_mutex;
+        std::condition_variable work_available;
+        std::condition_variable all_done;
+        std::atomic<int> queued{0}; // Tarefas ainda em alguma fila
+        int pending = 0;            // Tarefas enviadas e ainda não concluídas
+        bool stopping = false;
+};
+
+#endif // THREAD_POOL_HPP
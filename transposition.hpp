@@ -0,0 +1,91 @@
+#ifndef TRANSPOSITION_HPP
+#define TRANSPOSITION_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+
+// Tabela de transposição de tamanho fixo (2^bits entradas), indexada pelo
+// hash de Zobrist e compartilhada pelas threads da busca sem trava. Cada
+// entrada guarda a chave misturada por XOR com os dados: uma escrita pela
+// metade, vista por outra thread, não confere com a chave e vira uma falta
+// em vez de um valor errado. Colisão de índice substitui por profundidade:
+// a entrada nova só ocupa o lugar de uma da mesma busca se tiver pelo menos
+// a mesma profundidade; as de buscas anteriores são sempre substituíveis.
+class TranspositionTable{
+    public:
+        static const int DEFAULT_BITS = 16;
+        static const int MAX_DEPTH = 255;
+
+        struct Entry {
+            double value;
+            int depth;
+        };
+
+        explicit TranspositionTable(int bits = DEFAULT_BITS)
+            : mask((1ULL << bits) - 1), slots(new Slot[(size_t)1 << bits]) {
+            clear();
+        }
+
+        size_t getSize() const { return (size_t)mask + 1; }
+
+        // Chamados entre buscas, com as threads paradas
+        void clear(){
+            for (size_t i = 0; i <= mask; i++) {
+                slots[i].check.store(0, std::memory_order_relaxed);
+                slots[i].value.store(0, std::memory_order_relaxed);
+                slots[i].meta.store(0, std::memory_order_relaxed);
+            }
+            generation = 0;
+        }
+        void newSearch() { generation = (generation + 1) & 0xff; }
+
+        bool probe(uint64_t key, Entry &entry) const {
+            const Slot &slot = slots[key & mask];
+            uint64_t meta = slot.meta.load(std::memory_order_relaxed);
+            uint64_t value = slot.value.load(std::memory_order_relaxed);
+            uint64_t check = slot.check.load(std::memory_order_relaxed);
+            if (!(meta & VALID) || (check ^ value ^ meta) != key) return false;
+
+            memcpy(&entry.value, &value, sizeof(value));
+            entry.depth = (int)(meta & 0xff);
+            return true;
+        }
+
+        void store(uint64_t key, double value, int depth){
+            if (depth < 0) depth = 0;
+            if (depth > MAX_DEPTH) depth = MAX_DEPTH;
+
+            Slot &slot = slots[key & mask];
+            uint64_t old_meta = slot.meta.load(std::memory_order_relaxed);
+            if (old_meta & VALID) {
+                uint64_t old_key = slot.check.load(std::memory_order_relaxed)
+                                 ^ slot.value.load(std::memory_order_relaxed) ^ old_meta;
+                bool same_search = (int)((old_meta >> 8) & 0xff) == generation;
+                if (old_key != key && same_search && depth < (int)(old_meta & 0xff)) return;
+            }
+
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            uint64_t meta = VALID | (uint64_t)generation << 8 | (uint64_t)depth;
+            slot.meta.store(meta, std::memory_order_relaxed);
+            slot.value.store(bits, std::memory_order_relaxed);
+            slot.check.store(key ^ bits ^ meta, std::memory_order_relaxed);
+        }
+
+    private:
+        static const uint64_t VALID = 1ULL << 16;
+
+        struct Slot {
+            std::atomic<uint64_t> check; // Chave ^ value ^ meta
+            std::atomic<uint64_t> value; // Bits do double
+            std::atomic<uint64_t> meta;  // Profundidade, geração e VALID
+        };
+
+        uint64_t mask;
+        std::unique_ptr<Slot[]> slots;
+        int generation = 0;
+};
+
+#endif // TRANSPOSITION_HPP